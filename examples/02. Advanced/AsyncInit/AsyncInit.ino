@@ -0,0 +1,52 @@
+/**
+ * This example contains an application which initializes multiple PCA9622 devices without blocking the loop
+ * The oscillators of all devices start at the same time and the loop keeps running while they start
+ * This example is only interesting if you have multiple PCA9622 devices
+ */
+
+// Include the library
+#include "PCA9622.h"
+#include "PCA9622Array.h"
+
+#define PCA9622_I2C_ADDRESS_1 0xA2 // NOTE: Make sure to use the correct I2C address as the PCA9622 can have 128 different addresses
+#define PCA9622_I2C_ADDRESS_2 0xA4 // NOTE: Make sure to use the correct I2C address as the PCA9622 can have 128 different addresses
+#define DEVICE_COUNT 2
+
+PCA9622 devices[DEVICE_COUNT] = {PCA9622(PCA9622_I2C_ADDRESS_1), PCA9622(PCA9622_I2C_ADDRESS_2)}; // Create the device objects
+uint8_t framebuffer[DEVICE_COUNT * PCA9622_OUTPUT_COUNT]; // The framebuffer holds a PWM value for every output
+
+PCA9622Array fixture(devices, DEVICE_COUNT, framebuffer); // Create the array from the devices and the framebuffer
+
+bool initialized = false;
+unsigned long loops = 0;
+unsigned long start = 0;
+
+void setup() {
+  // put your setup code here, to run once:
+  Serial.begin(115200);
+  Wire.begin();
+
+  // Support for 400kHz is available. Comment this to use the default 100kHz
+  Wire.setClock(400000UL);
+
+  // Start the initialization of all devices, this returns right away
+  fixture.fill(0x10);
+  start = micros();
+  if (!fixture.beginAsync()) {
+    Serial.println("A device is still busy");
+  }
+}
+
+void loop() {
+  // put your main code here, to run repeatedly:
+  loops++;
+
+  // Runs the next step of every device. Never waits
+  if (!initialized && !fixture.poll()) {
+    initialized = true;
+    Serial.print("Initialized in "); Serial.print(micros() - start); Serial.print("us while the loop ran "); Serial.print(loops); Serial.println(" times");
+
+    // The devices are ready, write the framebuffer
+    fixture.flush();
+  }
+}
@@ -0,0 +1,56 @@
+/**
+ * This example contains an application which puts the PCA9622 to sleep when all outputs are off
+ * The device is woken up automatically as soon as an output is turned on again
+ */
+
+// Include the library
+#include "PCA9622.h"
+
+#define PCA9622_I2C_ADDRESS 0xA2 // NOTE: Make sure to use the correct I2C address as the PCA9622 can have 128 different addresses
+#define OUTPUT_ENABLE_PIN 2 // The ~OE (Output Enable) pin of the device.
+
+PCA9622 device(PCA9622_I2C_ADDRESS, OUTPUT_ENABLE_PIN); // Create a device object with the specified I2C_address and output enable pin
+
+// If you don't have an enable pin use this device initializer instead
+// PCA9622 device(PCA9622_I2C_ADDRESS);
+
+unsigned long lastToggle = 0;
+bool on = false;
+
+void setup() {
+  // put your setup code here, to run once:
+  Serial.begin(115200);
+  Wire.begin();
+
+  // Support for 400kHz is available. Comment this to use the default 100kHz
+  Wire.setClock(400000UL);
+
+  // Initialize the device
+  device.begin();
+
+  // Enable the outputs (only used if an output enable pin has been specified)
+  device.enableOutputs();
+
+  // Put the device to sleep after all outputs have been off for 1 second
+  device.setAutoSleep(1000);
+}
+
+void loop() {
+  // put your main code here, to run repeatedly:
+  // Runs the sleep management. Call this as often as possible
+  device.update();
+
+  unsigned long elapsed = millis() - lastToggle;
+  if (elapsed >= 5000) {
+    lastToggle = millis();
+    on = !on;
+    // Turning an output on wakes the device when it is asleep
+    device.setAllPWMOutputs(on ? 0x20 : 0x00);
+
+    Serial.print("Asleep: "); Serial.print(device.getSleepTime()); Serial.print("ms in "); Serial.print(device.getSleepCount()); Serial.println(" periods");
+  } else if (!on && elapsed >= 4990) {
+    // Let the device know the outputs will be turned on shortly. 
+    // The device is woken up early so the oscillator is running when the outputs turn on
+    device.scheduleActivity(5000 - elapsed);
+  }
+}
@@ -0,0 +1,87 @@
+/**
+ * This example contains an application which shows the HSV, HSL and color temperature functions of the PCA9622 library
+ * At startup the conversion functions are benchmarked and the results are printed on the serial port
+ */
+
+// Include the library
+#include "PCA9622.h"
+
+#define PCA9622_I2C_ADDRESS 0xA2 // NOTE: Make sure to use the correct I2C address as the PCA9622 can have 128 different addresses
+#define OUTPUT_ENABLE_PIN 2 // The ~OE (Output Enable) pin of the device.
+
+#define BENCHMARK_PIXELS 64 // The amount of colors converted per benchmark run
+
+PCA9622 device(PCA9622_I2C_ADDRESS, OUTPUT_ENABLE_PIN, RGB); // Create a device object with the specified I2C_address, output enable pin and LED configuration
+
+// If you don't have an enable pin use this device initializer instead
+// PCA9622 device(PCA9622_I2C_ADDRESS);
+
+uint8_t input[BENCHMARK_PIXELS * 3];
+uint16_t temperatures[BENCHMARK_PIXELS];
+uint8_t output[BENCHMARK_PIXELS * 3];
+
+void printResult(const char *name, uint32_t duration) {
+  Serial.print(name); Serial.print(": "); Serial.print(duration); Serial.print("us for "); Serial.print(BENCHMARK_PIXELS); Serial.print(" pixels, ~");
+  Serial.print((duration * (F_CPU / 1000000UL)) / BENCHMARK_PIXELS); Serial.println(" cycles per pixel");
+}
+
+void benchmark() {
+  for (uint16_t i = 0; i < BENCHMARK_PIXELS; i++) {
+    input[i * 3 + 0] = i * 4;
+    input[i * 3 + 1] = 255 - i;
+    input[i * 3 + 2] = 128 + i;
+    temperatures[i] = PCA9622_KELVIN_MIN + i * 150;
+  }
+
+  uint32_t start = micros();
+  PCA9622::hsvToRGB(input, output, BENCHMARK_PIXELS);
+  printResult("HSV", micros() - start);
+
+  start = micros();
+  PCA9622::hslToRGB(input, output, BENCHMARK_PIXELS);
+  printResult("HSL", micros() - start);
+
+  start = micros();
+  PCA9622::kelvinToRGB(temperatures, 255, output, BENCHMARK_PIXELS);
+  printResult("Kelvin", micros() - start);
+}
+
+void setup() {
+  // put your setup code here, to run once:
+  Serial.begin(115200);
+  Wire.begin();
+
+  // Support for 400kHz is available. Comment this to use the default 100kHz
+  Wire.setClock(400000UL);
+
+  benchmark();
+
+  // Initialize the device
+  device.begin();
+
+  // Enable the outputs (only used if an output enable pin has been specified)
+  device.enableOutputs();
+}
+
+void loop() {
+  // put your main code here, to run repeatedly:
+  // Rotate a rainbow over all 5 LEDs, every LED is shifted 51 steps on the color wheel
+  uint8_t hsv[3 * 5];
+  for (uint8_t hue = 0; hue < 255; hue++) {
+    for (uint8_t led = 0; led < 5; led++) {
+      hsv[led * 3 + 0] = hue + led * 51;
+      hsv[led * 3 + 1] = 255;
+      hsv[led * 3 + 2] = 64;
+    }
+    device.setLEDColorsHSV(0, hsv, 5); // All 5 LEDs in a single transaction
+    delay(20);
+  }
+
+  // Sweep all LEDs from warm to cold white
+  for (uint16_t kelvin = 2000; kelvin <= 8000; kelvin += 50) {
+    for (uint8_t led = 0; led < 5; led++) {
+      device.setLEDColorTemperature(led, kelvin, 64);
+    }
+    delay(20);
+  }
+}
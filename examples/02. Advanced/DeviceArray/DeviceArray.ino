@@ -0,0 +1,69 @@
+/**
+ * This example contains an application which drives multiple PCA9622 devices through a shared framebuffer
+ * Only the changed outputs are written on every flush and the total current of the fixture is limited
+ * This example is only interesting if you have multiple PCA9622 devices
+ */
+
+// Include the library
+#include "PCA9622.h"
+#include "PCA9622Array.h"
+
+#define PCA9622_I2C_ADDRESS_1 0xA2 // NOTE: Make sure to use the correct I2C address as the PCA9622 can have 128 different addresses
+#define PCA9622_I2C_ADDRESS_2 0xA4 // NOTE: Make sure to use the correct I2C address as the PCA9622 can have 128 different addresses
+#define DEVICE_COUNT 2
+
+#define CHANNEL_CURRENT 20 // The output current in mA set by the REXT resistor
+#define CURRENT_BUDGET 400 // The maximum current the power supply can deliver in mA
+
+PCA9622 devices[DEVICE_COUNT] = {PCA9622(PCA9622_I2C_ADDRESS_1), PCA9622(PCA9622_I2C_ADDRESS_2)}; // Create the device objects
+uint8_t framebuffer[DEVICE_COUNT * PCA9622_OUTPUT_COUNT]; // The framebuffer holds a PWM value for every output
+
+PCA9622Array fixture(devices, DEVICE_COUNT, framebuffer); // Create the array from the devices and the framebuffer
+
+void setup() {
+  // put your setup code here, to run once:
+  Serial.begin(115200);
+  Wire.begin();
+
+  // Support for 400kHz is available. Comment this to use the default 100kHz
+  Wire.setClock(400000UL);
+
+  // Devices can be split over multiple I2C buses. flush writes the buses one after the other, so this does not make a frame faster
+  // Wire1.begin();
+  // fixture.setDeviceBus(1, &Wire1);
+
+  // Initialize all devices. Fails when devices were left out, for example because they use too many buses
+  if (!fixture.begin()) {
+    Serial.println("Not all devices fit in the array");
+  }
+
+  // Limit the total current. When all outputs are fully on the fixture would draw 2 * 16 * 20mA = 640mA
+  fixture.setChannelCurrent(CHANNEL_CURRENT);
+  fixture.setCurrentBudget(CURRENT_BUDGET);
+
+  // Check the devices in the background with at most 5% of the bus time and repair them when they lost their state, for example after a brownout
+  fixture.setVerification(5);
+}
+
+void loop() {
+  // put your main code here, to run repeatedly:
+  // Light up the outputs one by one and write all changes once per frame
+  for (uint8_t d = 0; d < DEVICE_COUNT; d++) {
+    for (uint8_t output = 0; output < PCA9622_OUTPUT_COUNT; output++) {
+      fixture.setPWM(d, output, 255);
+      fixture.flush();
+      fixture.update();
+
+      Serial.print("Estimated: "); Serial.print(fixture.getEstimatedCurrent()); Serial.print("mA, scale: "); Serial.println(fixture.getCurrentScale());
+      delay(50);
+    }
+  }
+
+  for (uint8_t b = 0; b < fixture.getBusCount(); b++) {
+    Serial.print("Bus "); Serial.print(b); Serial.print(": "); Serial.print(fixture.getBusFrameBytes(b)); Serial.print(" bytes in "); Serial.print(fixture.getBusFrameTime(b)); Serial.println("us");
+  }
+
+  // Turn the whole fixture off with a single transaction per bus
+  fixture.fillBroadcast(0);
+  delay(500);
+}
@@ -0,0 +1,47 @@
+/**
+ * This example contains an application which finds all PCA9622 devices on the I2C bus
+ * No I2C addresses have to be configured, the found devices are pulsed one after another
+ */
+
+// Include the library
+#include "PCA9622.h"
+
+#define MAX_DEVICES 8 // The maximum amount of devices to look for
+
+PCA9622 devices[MAX_DEVICES]; // Create device objects without an address, the scan assigns the addresses
+uint8_t deviceCount = 0;
+
+void setup() {
+  // put your setup code here, to run once:
+  Serial.begin(115200);
+  Wire.begin();
+
+  // Support for 400kHz is available. Comment this to use the default 100kHz
+  Wire.setClock(400000UL);
+
+  // Scan the bus. The duration of the scan is optional
+  uint32_t duration;
+  deviceCount = PCA9622::scan(devices, MAX_DEVICES, &duration);
+
+  Serial.print("Found "); Serial.print(deviceCount); Serial.print(" devices in "); Serial.print(duration); Serial.println("us");
+  for (uint8_t i = 0; i < deviceCount; i++) {
+    Serial.print("  0x"); Serial.println(devices[i].getI2CAddress(), HEX);
+
+    // Initialize the device
+    devices[i].begin();
+  }
+}
+
+void loop() {
+  // put your main code here, to run repeatedly:
+  for (uint8_t d = 0; d < deviceCount; d++) {
+    for (int i = 0; i <= 255; i++) {
+      devices[d].setAllPWMOutputs(i);
+      delay(2);
+    }
+    for (int i = 255; i >= 0; i--) {
+      devices[d].setAllPWMOutputs(i);
+      delay(2);
+    }
+  }
+}
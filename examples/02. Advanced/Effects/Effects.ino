@@ -0,0 +1,64 @@
+/**
+ * This example contains an application which runs animation effects on multiple PCA9622 devices with RGB LEDs
+ * The effects are layered with blend modes and only the pixels that change are rendered and written to the devices
+ * This example works with a single device as well, set DEVICE_COUNT to 1
+ */
+
+// Include the library
+#include "PCA9622.h"
+#include "PCA9622Array.h"
+#include "PCA9622Effects.h"
+
+#define PCA9622_I2C_ADDRESS_1 0xA2 // NOTE: Make sure to use the correct I2C address as the PCA9622 can have 128 different addresses
+#define PCA9622_I2C_ADDRESS_2 0xA4 // NOTE: Make sure to use the correct I2C address as the PCA9622 can have 128 different addresses
+#define DEVICE_COUNT 2
+#define PIXEL_COUNT (DEVICE_COUNT * 5) // 5 RGB LEDs per device
+
+PCA9622 devices[DEVICE_COUNT] = {PCA9622(PCA9622_I2C_ADDRESS_1, 0xFF, LED_Configuration::RGB), PCA9622(PCA9622_I2C_ADDRESS_2, 0xFF, LED_Configuration::RGB)}; // Create the device objects
+uint8_t framebuffer[DEVICE_COUNT * PCA9622_OUTPUT_COUNT]; // The framebuffer holds a PWM value for every output
+
+PCA9622Array fixture(devices, DEVICE_COUNT, framebuffer); // Create the array from the devices and the framebuffer
+PCA9622Effects effects(fixture, 3); // Render the effects on RGB LEDs (3 outputs per pixel)
+
+PCA9622Rainbow rainbow(0, PIXEL_COUNT, 5000, 256 / PIXEL_COUNT, 255, 64); // A dim rainbow as background
+PCA9622Chase chase(0, PIXEL_COUNT, 255, 255, 255, 100, 3); // A white dot with a tail of 3 pixels
+PCA9622Sparkle sparkle(0, PIXEL_COUNT, 0, 0, 255, 64, 16); // Blue sparkles
+PCA9622Breathe breathe(0, PIXEL_COUNT, 255, 64, 0, 3000); // Orange breathing
+
+unsigned long lastReport = 0;
+uint16_t renderedPixels = 0;
+
+void setup() {
+  // put your setup code here, to run once:
+  Serial.begin(115200);
+  Wire.begin();
+
+  // Support for 400kHz is available. Comment this to use the default 100kHz
+  Wire.setClock(400000UL);
+
+  // Initialize all devices
+  fixture.begin();
+
+  // The layers are blended from the bottom to the top in the order they are added
+  effects.addEffect(rainbow);
+  effects.addEffect(chase, EBlendMode::Max);
+  effects.addEffect(sparkle, EBlendMode::Add);
+  effects.addEffect(breathe, EBlendMode::Alpha, 0); // Invisible until faded in
+}
+
+void loop() {
+  // put your main code here, to run repeatedly:
+  // Cross fade to the breathing effect and back every 10 seconds
+  uint16_t phase = (millis() / 20) % 500;
+  effects.setAlpha(breathe, (phase < 250) ? 0 : ((phase < 375) ? (phase - 250) * 2 : (500 - phase) * 2));
+
+  // Render the changed pixels and write the changed outputs
+  renderedPixels += effects.update();
+  fixture.flush();
+
+  if (millis() - lastReport >= 1000) {
+    lastReport = millis();
+    Serial.print("Rendered pixels per second: "); Serial.print(renderedPixels); Serial.print(", last frame: "); Serial.print(fixture.getBusFrameBytes(0)); Serial.println(" bytes");
+    renderedPixels = 0;
+  }
+}
@@ -0,0 +1,78 @@
+/**
+ * This example contains an application which plays a light show from flash on 2 PCA9622 devices
+ * The show in show.h was created with: extras/frame_encoder.py --demo --devices 2 -o show.h
+ * Every frame only holds the registers that changed, which are written in a single burst per span
+ * At the start the compression ratio and the decode time are measured, with and without the I2C writes
+ */
+
+// Include the library
+#include "PCA9622.h"
+#include "PCA9622FramePlayer.h"
+#include "show.h"
+
+#define PCA9622_I2C_ADDRESS_1 0xA2 // NOTE: Make sure to use the correct I2C address as the PCA9622 can have 128 different addresses
+#define PCA9622_I2C_ADDRESS_2 0xA4 // NOTE: Make sure to use the correct I2C address as the PCA9622 can have 128 different addresses
+#define DEVICE_COUNT 2
+
+PCA9622 devices[DEVICE_COUNT] = {PCA9622(PCA9622_I2C_ADDRESS_1), PCA9622(PCA9622_I2C_ADDRESS_2)}; // Create the device objects
+
+PCA9622FramePlayer player(devices, DEVICE_COUNT); // Plays the show on the devices
+PCA9622FramePlayer decoder(nullptr, 0); // Only decodes the show, used to measure the decoder
+
+/**
+ * @brief Decodes the whole show as fast as possible and prints the time it took
+ * 
+ * @param name The name of the measurement
+ * @param measured The player to measure
+ */
+void benchmark(const char *name, PCA9622FramePlayer &measured) {
+  measured.rewind();
+  unsigned long start = micros();
+  while (measured.nextFrame() > 0);
+  unsigned long elapsed = micros() - start;
+  uint32_t frames = measured.getFrame(); // Frames that are shown for several frame periods count once per period, like SHOW_FRAMES
+
+  Serial.print(name); Serial.print(": "); Serial.print(elapsed); Serial.print("us, ");
+  Serial.print(elapsed / frames); Serial.print("us per frame");
+#ifdef F_CPU
+  Serial.print(", "); Serial.print((F_CPU / 1000000UL) * elapsed / frames); Serial.print(" cycles per frame");
+#endif
+  Serial.print(", "); Serial.print((float)frames * measured.getFramePeriod() * 1000 / elapsed); Serial.println("x real time");
+}
+
+void setup() {
+  // put your setup code here, to run once:
+  Serial.begin(115200);
+  Wire.begin();
+
+  // Support for 400kHz is available. Comment this to use the default 100kHz
+  Wire.setClock(400000UL);
+
+  for (uint8_t i = 0; i < DEVICE_COUNT; i++) {
+    devices[i].begin();
+  }
+
+  if (player.begin(show) != 0 || decoder.begin(show) != 0) {
+    Serial.println("Invalid show");
+    while (true);
+  }
+
+  Serial.print("Show: "); Serial.print(SHOW_FRAMES); Serial.print(" frames of "); Serial.print(player.getFramePeriod()); Serial.println("ms");
+  Serial.print("Size: "); Serial.print(SHOW_RAW_SIZE); Serial.print(" bytes raw, "); Serial.print(sizeof(show)); Serial.print(" bytes encoded, ratio ");
+  Serial.print((float)SHOW_RAW_SIZE / sizeof(show)); Serial.println(":1");
+
+  benchmark("Decode only", decoder);
+  benchmark("Decode and write", player);
+
+  // Play the show in real time
+  player.rewind();
+}
+
+void loop() {
+  // put your main code here, to run repeatedly:
+
+  // Writes the next frame when it is time, loops the show
+  if (!player.update()) {
+    player.rewind();
+  }
+}
@@ -0,0 +1,122 @@
+// Generated by extras/frame_encoder.py: 240 frames, 2 devices, 16 registers from 0x02, 20 ms per frame
+// 7680 bytes raw, 1794 bytes encoded (4.3:1)
+#include <Arduino.h>
+
+#define SHOW_FRAMES 240
+#define SHOW_RAW_SIZE 7680
+
+const uint8_t show[] PROGMEM = {
+    0x50, 0x46, 0x02, 0x02, 0x14, 0x00, 0x02, 0x07, 0x00, 0x00, 0x40, 0x02, 0xFF, 0x8E, 0x03, 0x00,
+    0x01, 0x01, 0x8A, 0x02, 0x00, 0x44, 0x0D, 0x07, 0x0F, 0x1F, 0x3F, 0x7F, 0xC1, 0x41, 0x02, 0x7F,
+    0xFF, 0x01, 0x01, 0x44, 0x0D, 0x00, 0x07, 0x0F, 0x1F, 0x3F, 0xC1, 0x42, 0x02, 0x3F, 0x7F, 0xFF,
+    0x01, 0x01, 0x43, 0x0E, 0x00, 0x07, 0x0F, 0x1F, 0xC1, 0x43, 0x02, 0x1F, 0x3F, 0x7F, 0xFF, 0x01,
+    0x01, 0x42, 0x0F, 0x00, 0x07, 0x0F, 0xC1, 0x44, 0x02, 0x0F, 0x1F, 0x3F, 0x7F, 0xFF, 0x01, 0x01,
+    0x41, 0x10, 0x00, 0x07, 0xC1, 0x45, 0x02, 0x07, 0x0F, 0x1F, 0x3F, 0x7F, 0xFF, 0x01, 0x01, 0x40,
+    0x11, 0x00, 0xC1, 0x46, 0x02, 0x00, 0x07, 0x0F, 0x1F, 0x3F, 0x7F, 0xFF, 0xC1, 0x46, 0x03, 0x00,
+    0x07, 0x0F, 0x1F, 0x3F, 0x7F, 0xFF, 0xC1, 0x46, 0x04, 0x00, 0x07, 0x0F, 0x1F, 0x3F, 0x7F, 0xFF,
+    0xC1, 0x46, 0x05, 0x00, 0x07, 0x0F, 0x1F, 0x3F, 0x7F, 0xFF, 0xC1, 0x46, 0x06, 0x00, 0x07, 0x0F,
+    0x1F, 0x3F, 0x7F, 0xFF, 0xC1, 0x46, 0x07, 0x00, 0x07, 0x0F, 0x1F, 0x3F, 0x7F, 0xFF, 0xC1, 0x46,
+    0x08, 0x00, 0x07, 0x0F, 0x1F, 0x3F, 0x7F, 0xFF, 0xC1, 0x46, 0x09, 0x00, 0x07, 0x0F, 0x1F, 0x3F,
+    0x7F, 0xFF, 0xC1, 0x46, 0x0A, 0x00, 0x07, 0x0F, 0x1F, 0x3F, 0x7F, 0xFF, 0xC1, 0x46, 0x0B, 0x00,
+    0x07, 0x0F, 0x1F, 0x3F, 0x7F, 0xFF, 0xC1, 0x45, 0x0C, 0x00, 0x07, 0x0F, 0x1F, 0x3F, 0x7F, 0x01,
+    0x01, 0x40, 0x02, 0xFF, 0xC1, 0x44, 0x0D, 0x00, 0x07, 0x0F, 0x1F, 0x3F, 0x01, 0x01, 0x41, 0x02,
+    0x7F, 0xFF, 0xC1, 0x43, 0x0E, 0x00, 0x07, 0x0F, 0x1F, 0x01, 0x01, 0x42, 0x02, 0x3F, 0x7F, 0xFF,
+    0xC1, 0x42, 0x0F, 0x00, 0x07, 0x0F, 0x01, 0x01, 0x43, 0x02, 0x1F, 0x3F, 0x7F, 0xFF, 0xC1, 0x41,
+    0x10, 0x00, 0x07, 0x01, 0x01, 0x44, 0x02, 0x0F, 0x1F, 0x3F, 0x7F, 0xFF, 0xC1, 0x40, 0x11, 0x00,
+    0x01, 0x01, 0x45, 0x02, 0x07, 0x0F, 0x1F, 0x3F, 0x7F, 0xFF, 0xC1, 0x01, 0x01, 0x46, 0x02, 0x00,
+    0x07, 0x0F, 0x1F, 0x3F, 0x7F, 0xFF, 0xC1, 0x01, 0x01, 0x46, 0x03, 0x00, 0x07, 0x0F, 0x1F, 0x3F,
+    0x7F, 0xFF, 0xC1, 0x01, 0x01, 0x46, 0x04, 0x00, 0x07, 0x0F, 0x1F, 0x3F, 0x7F, 0xFF, 0xC1, 0x01,
+    0x01, 0x46, 0x05, 0x00, 0x07, 0x0F, 0x1F, 0x3F, 0x7F, 0xFF, 0xC1, 0x01, 0x01, 0x46, 0x06, 0x00,
+    0x07, 0x0F, 0x1F, 0x3F, 0x7F, 0xFF, 0xC1, 0x01, 0x01, 0x46, 0x07, 0x00, 0x07, 0x0F, 0x1F, 0x3F,
+    0x7F, 0xFF, 0xC1, 0x01, 0x01, 0x46, 0x08, 0x00, 0x07, 0x0F, 0x1F, 0x3F, 0x7F, 0xFF, 0xC1, 0x01,
+    0x01, 0x46, 0x09, 0x00, 0x07, 0x0F, 0x1F, 0x3F, 0x7F, 0xFF, 0xC1, 0x01, 0x01, 0x46, 0x0A, 0x00,
+    0x07, 0x0F, 0x1F, 0x3F, 0x7F, 0xFF, 0xC1, 0x01, 0x01, 0x46, 0x0B, 0x00, 0x07, 0x0F, 0x1F, 0x3F,
+    0x7F, 0xFF, 0xC1, 0x40, 0x02, 0xFF, 0x01, 0x01, 0x45, 0x0C, 0x00, 0x07, 0x0F, 0x1F, 0x3F, 0x7F,
+    0xC1, 0x41, 0x02, 0x7F, 0xFF, 0x01, 0x01, 0x44, 0x0D, 0x00, 0x07, 0x0F, 0x1F, 0x3F, 0xC1, 0x42,
+    0x02, 0x3F, 0x7F, 0xFF, 0x01, 0x01, 0x43, 0x0E, 0x00, 0x07, 0x0F, 0x1F, 0xC1, 0x43, 0x02, 0x1F,
+    0x3F, 0x7F, 0xFF, 0x01, 0x01, 0x42, 0x0F, 0x00, 0x07, 0x0F, 0xC1, 0x44, 0x02, 0x0F, 0x1F, 0x3F,
+    0x7F, 0xFF, 0x01, 0x01, 0x41, 0x10, 0x00, 0x07, 0xC1, 0x45, 0x02, 0x07, 0x0F, 0x1F, 0x3F, 0x7F,
+    0xFF, 0x01, 0x01, 0x40, 0x11, 0x00, 0xC1, 0x46, 0x02, 0x00, 0x07, 0x0F, 0x1F, 0x3F, 0x7F, 0xFF,
+    0xC1, 0x46, 0x03, 0x00, 0x07, 0x0F, 0x1F, 0x3F, 0x7F, 0xFF, 0xC1, 0x46, 0x04, 0x00, 0x07, 0x0F,
+    0x1F, 0x3F, 0x7F, 0xFF, 0xC1, 0x46, 0x05, 0x00, 0x07, 0x0F, 0x1F, 0x3F, 0x7F, 0xFF, 0xC1, 0x46,
+    0x06, 0x00, 0x07, 0x0F, 0x1F, 0x3F, 0x7F, 0xFF, 0xC1, 0x46, 0x07, 0x00, 0x07, 0x0F, 0x1F, 0x3F,
+    0x7F, 0xFF, 0xC1, 0x46, 0x08, 0x00, 0x07, 0x0F, 0x1F, 0x3F, 0x7F, 0xFF, 0xC1, 0x46, 0x09, 0x00,
+    0x07, 0x0F, 0x1F, 0x3F, 0x7F, 0xFF, 0xC1, 0x46, 0x0A, 0x00, 0x07, 0x0F, 0x1F, 0x3F, 0x7F, 0xFF,
+    0xC1, 0x46, 0x0B, 0x00, 0x07, 0x0F, 0x1F, 0x3F, 0x7F, 0xFF, 0xC1, 0x45, 0x0C, 0x00, 0x07, 0x0F,
+    0x1F, 0x3F, 0x7F, 0x01, 0x01, 0x40, 0x02, 0xFF, 0xC1, 0x44, 0x0D, 0x00, 0x07, 0x0F, 0x1F, 0x3F,
+    0x01, 0x01, 0x41, 0x02, 0x7F, 0xFF, 0xC1, 0x43, 0x0E, 0x00, 0x07, 0x0F, 0x1F, 0x01, 0x01, 0x42,
+    0x02, 0x3F, 0x7F, 0xFF, 0xC1, 0x42, 0x0F, 0x00, 0x07, 0x0F, 0x01, 0x01, 0x43, 0x02, 0x1F, 0x3F,
+    0x7F, 0xFF, 0xC1, 0x41, 0x10, 0x00, 0x07, 0x01, 0x01, 0x44, 0x02, 0x0F, 0x1F, 0x3F, 0x7F, 0xFF,
+    0xC1, 0x40, 0x11, 0x00, 0x01, 0x01, 0x45, 0x02, 0x07, 0x0F, 0x1F, 0x3F, 0x7F, 0xFF, 0xC1, 0x01,
+    0x01, 0x46, 0x02, 0x00, 0x07, 0x0F, 0x1F, 0x3F, 0x7F, 0xFF, 0xC1, 0x01, 0x01, 0x46, 0x03, 0x00,
+    0x07, 0x0F, 0x1F, 0x3F, 0x7F, 0xFF, 0xC1, 0x01, 0x01, 0x46, 0x04, 0x00, 0x07, 0x0F, 0x1F, 0x3F,
+    0x7F, 0xFF, 0xC1, 0x01, 0x01, 0x46, 0x05, 0x00, 0x07, 0x0F, 0x1F, 0x3F, 0x7F, 0xFF, 0xC1, 0x01,
+    0x01, 0x46, 0x06, 0x00, 0x07, 0x0F, 0x1F, 0x3F, 0x7F, 0xFF, 0xC1, 0x01, 0x01, 0x46, 0x07, 0x00,
+    0x07, 0x0F, 0x1F, 0x3F, 0x7F, 0xFF, 0xC1, 0x01, 0x01, 0x85, 0x08, 0x00, 0xC1, 0x8F, 0x02, 0x02,
+    0x01, 0x01, 0x8F, 0x02, 0x02, 0xC0, 0x8F, 0x02, 0x06, 0x01, 0x01, 0x8F, 0x02, 0x06, 0xC0, 0x8F,
+    0x02, 0x0B, 0x01, 0x01, 0x8F, 0x02, 0x0B, 0xC0, 0x8F, 0x02, 0x11, 0x01, 0x01, 0x8F, 0x02, 0x11,
+    0xC0, 0x8F, 0x02, 0x18, 0x01, 0x01, 0x8F, 0x02, 0x18, 0xC0, 0x8F, 0x02, 0x20, 0x01, 0x01, 0x8F,
+    0x02, 0x20, 0xC0, 0x8F, 0x02, 0x2A, 0x01, 0x01, 0x8F, 0x02, 0x2A, 0xC0, 0x8F, 0x02, 0x34, 0x01,
+    0x01, 0x8F, 0x02, 0x34, 0xC0, 0x8F, 0x02, 0x3F, 0x01, 0x01, 0x8F, 0x02, 0x3F, 0xC0, 0x8F, 0x02,
+    0x4B, 0x01, 0x01, 0x8F, 0x02, 0x4B, 0xC0, 0x8F, 0x02, 0x58, 0x01, 0x01, 0x8F, 0x02, 0x58, 0xC0,
+    0x8F, 0x02, 0x64, 0x01, 0x01, 0x8F, 0x02, 0x64, 0xC0, 0x8F, 0x02, 0x72, 0x01, 0x01, 0x8F, 0x02,
+    0x72, 0xC0, 0x8F, 0x02, 0x7F, 0x01, 0x01, 0x8F, 0x02, 0x7F, 0xC0, 0x8F, 0x02, 0x8C, 0x01, 0x01,
+    0x8F, 0x02, 0x8C, 0xC0, 0x8F, 0x02, 0x9A, 0x01, 0x01, 0x8F, 0x02, 0x9A, 0xC0, 0x8F, 0x02, 0xA6,
+    0x01, 0x01, 0x8F, 0x02, 0xA6, 0xC0, 0x8F, 0x02, 0xB3, 0x01, 0x01, 0x8F, 0x02, 0xB3, 0xC0, 0x8F,
+    0x02, 0xBF, 0x01, 0x01, 0x8F, 0x02, 0xBF, 0xC0, 0x8F, 0x02, 0xCA, 0x01, 0x01, 0x8F, 0x02, 0xCA,
+    0xC0, 0x8F, 0x02, 0xD4, 0x01, 0x01, 0x8F, 0x02, 0xD4, 0xC0, 0x8F, 0x02, 0xDE, 0x01, 0x01, 0x8F,
+    0x02, 0xDE, 0xC0, 0x8F, 0x02, 0xE6, 0x01, 0x01, 0x8F, 0x02, 0xE6, 0xC0, 0x8F, 0x02, 0xED, 0x01,
+    0x01, 0x8F, 0x02, 0xED, 0xC0, 0x8F, 0x02, 0xF3, 0x01, 0x01, 0x8F, 0x02, 0xF3, 0xC0, 0x8F, 0x02,
+    0xF8, 0x01, 0x01, 0x8F, 0x02, 0xF8, 0xC0, 0x8F, 0x02, 0xFC, 0x01, 0x01, 0x8F, 0x02, 0xFC, 0xC0,
+    0x8F, 0x02, 0xFE, 0x01, 0x01, 0x8F, 0x02, 0xFE, 0xC0, 0x8F, 0x02, 0xFF, 0x01, 0x01, 0x8F, 0x02,
+    0xFF, 0xC0, 0x8F, 0x02, 0xFE, 0x01, 0x01, 0x8F, 0x02, 0xFE, 0xC0, 0x8F, 0x02, 0xFC, 0x01, 0x01,
+    0x8F, 0x02, 0xFC, 0xC0, 0x8F, 0x02, 0xF8, 0x01, 0x01, 0x8F, 0x02, 0xF8, 0xC0, 0x8F, 0x02, 0xF3,
+    0x01, 0x01, 0x8F, 0x02, 0xF3, 0xC0, 0x8F, 0x02, 0xED, 0x01, 0x01, 0x8F, 0x02, 0xED, 0xC0, 0x8F,
+    0x02, 0xE6, 0x01, 0x01, 0x8F, 0x02, 0xE6, 0xC0, 0x8F, 0x02, 0xDE, 0x01, 0x01, 0x8F, 0x02, 0xDE,
+    0xC0, 0x8F, 0x02, 0xD4, 0x01, 0x01, 0x8F, 0x02, 0xD4, 0xC0, 0x8F, 0x02, 0xCA, 0x01, 0x01, 0x8F,
+    0x02, 0xCA, 0xC0, 0x8F, 0x02, 0xBF, 0x01, 0x01, 0x8F, 0x02, 0xBF, 0xC0, 0x8F, 0x02, 0xB3, 0x01,
+    0x01, 0x8F, 0x02, 0xB3, 0xC0, 0x8F, 0x02, 0xA6, 0x01, 0x01, 0x8F, 0x02, 0xA6, 0xC0, 0x8F, 0x02,
+    0x9A, 0x01, 0x01, 0x8F, 0x02, 0x9A, 0xC0, 0x8F, 0x02, 0x8C, 0x01, 0x01, 0x8F, 0x02, 0x8C, 0xC0,
+    0x8F, 0x02, 0x7F, 0x01, 0x01, 0x8F, 0x02, 0x7F, 0xC0, 0x8F, 0x02, 0x72, 0x01, 0x01, 0x8F, 0x02,
+    0x72, 0xC0, 0x8F, 0x02, 0x64, 0x01, 0x01, 0x8F, 0x02, 0x64, 0xC0, 0x8F, 0x02, 0x58, 0x01, 0x01,
+    0x8F, 0x02, 0x58, 0xC0, 0x8F, 0x02, 0x4B, 0x01, 0x01, 0x8F, 0x02, 0x4B, 0xC0, 0x8F, 0x02, 0x3F,
+    0x01, 0x01, 0x8F, 0x02, 0x3F, 0xC0, 0x8F, 0x02, 0x34, 0x01, 0x01, 0x8F, 0x02, 0x34, 0xC0, 0x8F,
+    0x02, 0x2A, 0x01, 0x01, 0x8F, 0x02, 0x2A, 0xC0, 0x8F, 0x02, 0x20, 0x01, 0x01, 0x8F, 0x02, 0x20,
+    0xC0, 0x8F, 0x02, 0x18, 0x01, 0x01, 0x8F, 0x02, 0x18, 0xC0, 0x8F, 0x02, 0x11, 0x01, 0x01, 0x8F,
+    0x02, 0x11, 0xC0, 0x8F, 0x02, 0x0B, 0x01, 0x01, 0x8F, 0x02, 0x0B, 0xC0, 0x8F, 0x02, 0x06, 0x01,
+    0x01, 0x8F, 0x02, 0x06, 0xC0, 0x8F, 0x02, 0x02, 0x01, 0x01, 0x8F, 0x02, 0x02, 0xC0, 0x8F, 0x02,
+    0x00, 0x01, 0x01, 0x8F, 0x02, 0x00, 0xC2, 0x8F, 0x02, 0x02, 0x01, 0x01, 0x8F, 0x02, 0x02, 0xC0,
+    0x8F, 0x02, 0x06, 0x01, 0x01, 0x8F, 0x02, 0x06, 0xC0, 0x8F, 0x02, 0x0B, 0x01, 0x01, 0x8F, 0x02,
+    0x0B, 0xC0, 0x8F, 0x02, 0x11, 0x01, 0x01, 0x8F, 0x02, 0x11, 0xC0, 0x8F, 0x02, 0x18, 0x01, 0x01,
+    0x8F, 0x02, 0x18, 0xC0, 0x8F, 0x02, 0x20, 0x01, 0x01, 0x8F, 0x02, 0x20, 0xC0, 0x8F, 0x02, 0x2A,
+    0x01, 0x01, 0x8F, 0x02, 0x2A, 0xC0, 0x8F, 0x02, 0x34, 0x01, 0x01, 0x8F, 0x02, 0x34, 0xC0, 0x8F,
+    0x02, 0x3F, 0x01, 0x01, 0x8F, 0x02, 0x3F, 0xC0, 0x8F, 0x02, 0x4B, 0x01, 0x01, 0x8F, 0x02, 0x4B,
+    0xC0, 0x8F, 0x02, 0x58, 0x01, 0x01, 0x8F, 0x02, 0x58, 0xC0, 0x8F, 0x02, 0x64, 0x01, 0x01, 0x8F,
+    0x02, 0x64, 0xC0, 0x8F, 0x02, 0x72, 0x01, 0x01, 0x8F, 0x02, 0x72, 0xC0, 0x8F, 0x02, 0x7F, 0x01,
+    0x01, 0x8F, 0x02, 0x7F, 0xC0, 0x8F, 0x02, 0x8C, 0x01, 0x01, 0x8F, 0x02, 0x8C, 0xC0, 0x8F, 0x02,
+    0x9A, 0x01, 0x01, 0x8F, 0x02, 0x9A, 0xC0, 0x8F, 0x02, 0xA6, 0x01, 0x01, 0x8F, 0x02, 0xA6, 0xC0,
+    0x8F, 0x02, 0xB3, 0x01, 0x01, 0x8F, 0x02, 0xB3, 0xC0, 0x8F, 0x02, 0xBF, 0x01, 0x01, 0x8F, 0x02,
+    0xBF, 0xC0, 0x8F, 0x02, 0xCA, 0x01, 0x01, 0x8F, 0x02, 0xCA, 0xC0, 0x8F, 0x02, 0xD4, 0x01, 0x01,
+    0x8F, 0x02, 0xD4, 0xC0, 0x8F, 0x02, 0xDE, 0x01, 0x01, 0x8F, 0x02, 0xDE, 0xC0, 0x8F, 0x02, 0xE6,
+    0x01, 0x01, 0x8F, 0x02, 0xE6, 0xC0, 0x8F, 0x02, 0xED, 0x01, 0x01, 0x8F, 0x02, 0xED, 0xC0, 0x8F,
+    0x02, 0xF3, 0x01, 0x01, 0x8F, 0x02, 0xF3, 0xC0, 0x8F, 0x02, 0xF8, 0x01, 0x01, 0x8F, 0x02, 0xF8,
+    0xC0, 0x8F, 0x02, 0xFC, 0x01, 0x01, 0x8F, 0x02, 0xFC, 0xC0, 0x8F, 0x02, 0xFE, 0x01, 0x01, 0x8F,
+    0x02, 0xFE, 0xC0, 0x8F, 0x02, 0xFF, 0x01, 0x01, 0x8F, 0x02, 0xFF, 0xC0, 0x8F, 0x02, 0xFE, 0x01,
+    0x01, 0x8F, 0x02, 0xFE, 0xC0, 0x8F, 0x02, 0xFC, 0x01, 0x01, 0x8F, 0x02, 0xFC, 0xC0, 0x8F, 0x02,
+    0xF8, 0x01, 0x01, 0x8F, 0x02, 0xF8, 0xC0, 0x8F, 0x02, 0xF3, 0x01, 0x01, 0x8F, 0x02, 0xF3, 0xC0,
+    0x8F, 0x02, 0xED, 0x01, 0x01, 0x8F, 0x02, 0xED, 0xC0, 0x8F, 0x02, 0xE6, 0x01, 0x01, 0x8F, 0x02,
+    0xE6, 0xC0, 0x8F, 0x02, 0xDE, 0x01, 0x01, 0x8F, 0x02, 0xDE, 0xC0, 0x8F, 0x02, 0xD4, 0x01, 0x01,
+    0x8F, 0x02, 0xD4, 0xC0, 0x8F, 0x02, 0xCA, 0x01, 0x01, 0x8F, 0x02, 0xCA, 0xC0, 0x8F, 0x02, 0xBF,
+    0x01, 0x01, 0x8F, 0x02, 0xBF, 0xC0, 0x8F, 0x02, 0xB3, 0x01, 0x01, 0x8F, 0x02, 0xB3, 0xC0, 0x8F,
+    0x02, 0xA6, 0x01, 0x01, 0x8F, 0x02, 0xA6, 0xC0, 0x8F, 0x02, 0x9A, 0x01, 0x01, 0x8F, 0x02, 0x9A,
+    0xC0, 0x8F, 0x02, 0x8C, 0x01, 0x01, 0x8F, 0x02, 0x8C, 0xC0, 0x8F, 0x02, 0x7F, 0x01, 0x01, 0x8F,
+    0x02, 0x7F, 0xC0, 0x8F, 0x02, 0x72, 0x01, 0x01, 0x8F, 0x02, 0x72, 0xC0, 0x8F, 0x02, 0x64, 0x01,
+    0x01, 0x8F, 0x02, 0x64, 0xC0, 0x8F, 0x02, 0x58, 0x01, 0x01, 0x8F, 0x02, 0x58, 0xC0, 0x8F, 0x02,
+    0x4B, 0x01, 0x01, 0x8F, 0x02, 0x4B, 0xC0, 0x8F, 0x02, 0x3F, 0x01, 0x01, 0x8F, 0x02, 0x3F, 0xC0,
+    0x8F, 0x02, 0x34, 0x01, 0x01, 0x8F, 0x02, 0x34, 0xC0, 0x8F, 0x02, 0x2A, 0x01, 0x01, 0x8F, 0x02,
+    0x2A, 0xC0, 0x8F, 0x02, 0x20, 0x01, 0x01, 0x8F, 0x02, 0x20, 0xC0, 0x8F, 0x02, 0x18, 0x01, 0x01,
+    0x8F, 0x02, 0x18, 0xC0, 0x8F, 0x02, 0x11, 0x01, 0x01, 0x8F, 0x02, 0x11, 0xC0, 0x8F, 0x02, 0x0B,
+    0x01, 0x01, 0x8F, 0x02, 0x0B, 0xC0, 0x8F, 0x02, 0x06, 0x01, 0x01, 0x8F, 0x02, 0x06, 0xC0, 0x8F,
+    0x02, 0x02, 0x01, 0x01, 0x8F, 0x02, 0x02, 0xC0, 0x8F, 0x02, 0x00, 0x01, 0x01, 0x8F, 0x02, 0x00,
+    0xC0, 0x00,
+};
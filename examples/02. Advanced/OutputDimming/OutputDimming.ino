@@ -0,0 +1,45 @@
+/**
+ * This example contains an application which fades all outputs with PWM on the ~OE pin
+ * The fade costs no I2C transactions. Every PCA9622 that shares the ~OE pin fades at the same time
+ * NOTE: The ~OE pin has to be connected to a PWM capable pin of the Arduino
+ */
+
+// Include the library
+#include "PCA9622.h"
+
+#define PCA9622_I2C_ADDRESS 0xA2 // NOTE: Make sure to use the correct I2C address as the PCA9622 can have 128 different addresses
+#define OUTPUT_ENABLE_PIN 3 // The ~OE (Output Enable) pin of the device. Pin 3 supports PWM on most Arduino boards
+
+PCA9622 device(PCA9622_I2C_ADDRESS, OUTPUT_ENABLE_PIN); // Create a device object with the specified I2C_address and output enable pin
+
+void setup() {
+  // put your setup code here, to run once:
+  Serial.begin(115200);
+  Wire.begin();
+
+  // Support for 400kHz is available. Comment this to use the default 100kHz
+  Wire.setClock(400000UL);
+
+  // Initialize the device
+  device.begin();
+
+  // Set all outputs once, the fade below does not touch the I2C bus
+  device.setAllPWMOutputs(0xFF);
+
+  // Enable the outputs
+  device.enableOutputs();
+}
+
+void loop() {
+  // put your main code here, to run repeatedly:
+  // Fade in and out with gamma correction so the steps look even
+  for (uint16_t brightness = 0; brightness <= 0xFF; brightness++) {
+    device.setOutputBrightness(brightness, true);
+    delay(4);
+  }
+  for (int16_t brightness = 0xFF; brightness >= 0; brightness--) {
+    device.setOutputBrightness(brightness, true);
+    delay(4);
+  }
+  delay(500);
+}
@@ -0,0 +1,51 @@
+/**
+ * This example contains an application which blinks multiple PCA9622 devices in phase using the hardware group blinking
+ * The blinking is configured with broadcasts and restarted periodically so the devices do not drift apart
+ * This example is only interesting if you have multiple PCA9622 devices
+ */
+
+// Include the library
+#include "PCA9622.h"
+#include "PCA9622Array.h"
+
+#define PCA9622_I2C_ADDRESS_1 0xA2 // NOTE: Make sure to use the correct I2C address as the PCA9622 can have 128 different addresses
+#define PCA9622_I2C_ADDRESS_2 0xA4 // NOTE: Make sure to use the correct I2C address as the PCA9622 can have 128 different addresses
+#define DEVICE_COUNT 2
+
+PCA9622 devices[DEVICE_COUNT] = {PCA9622(PCA9622_I2C_ADDRESS_1), PCA9622(PCA9622_I2C_ADDRESS_2)}; // Create the device objects
+uint8_t framebuffer[DEVICE_COUNT * PCA9622_OUTPUT_COUNT]; // The framebuffer holds a PWM value for every output
+
+PCA9622Array fixture(devices, DEVICE_COUNT, framebuffer); // Create the array from the devices and the framebuffer
+
+/** 
+ * ----------------------------------- WARNING ----------------------------------
+ * if you or someone around you have problems with flickering lights due to 
+ * photosensitive epilepsie please do not use this sketch !!!!!
+ * ----------------------------------- WARNING ----------------------------------
+ */ 
+
+void setup() {
+  // put your setup code here, to run once:
+  Wire.begin();
+
+  // Support for 400kHz is available. Comment this to use the default 100kHz
+  Wire.setClock(400000UL);
+
+  // Initialize all devices
+  fixture.begin();
+
+  // Turn all outputs on, the group blinking switches them on and off
+  fixture.fill(0x40);
+  fixture.flush();
+
+  // Blink all devices every 500ms with a 50% duty cycle. Uses the AllCall address which is enabled by default
+  fixture.setGroupBlinking(500, 128);
+
+  // Restart the blinking of all devices every minute to correct the drift between the devices
+  fixture.setBlinkResyncInterval(60000UL);
+}
+
+void loop() {
+  // put your main code here, to run repeatedly:
+  fixture.update();
+}
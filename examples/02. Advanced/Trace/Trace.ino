@@ -0,0 +1,51 @@
+/**
+ * This example records all I2C traffic of the PCA9622 to the serial port in a compact binary trace
+ * Capture the serial output to a file on the computer, for example on Linux:
+ *   stty -F /dev/ttyACM0 115200 raw && cat /dev/ttyACM0 > trace.bin
+ * Replay the trace with extras/trace_replay.py to see the output state after every frame and the bus cost:
+ *   python3 extras/trace_replay.py trace.bin --frames
+ * Comparing the traces of two firmware versions shows the difference in bus cost and if the outputs are the same:
+ *   python3 extras/trace_replay.py old.bin new.bin
+ * Every record holds the I2C bus, so devices with the same address on Wire and Wire1 are replayed as separate devices
+ * 
+ * NOTE: Nothing else can be printed to the serial port while recording. A File on an SD card can be used instead of Serial
+ */
+
+// Include the library
+#include "PCA9622.h"
+
+#define PCA9622_I2C_ADDRESS 0xA2 // NOTE: Make sure to use the correct I2C address as the PCA9622 can have 128 different addresses
+
+PCA9622 device(PCA9622_I2C_ADDRESS); // Create a device object with the specified I2C_address
+
+uint8_t frame = 0;
+
+void setup() {
+  // put your setup code here, to run once:
+  Serial.begin(115200);
+  Wire.begin();
+
+  // Support for 400kHz is available. Comment this to use the default 100kHz
+  Wire.setClock(400000UL);
+
+  // Start recording before the device is initialized so the replay starts from the reset state
+  PCA9622::setTrace(&Serial);
+
+  // Initialize the device
+  device.begin();
+  device.setLEDConfiguration(LED_Configuration::RGB);
+}
+
+void loop() {
+  // put your main code here, to run repeatedly:
+  // Every frame is a single color for all LEDs
+  device.setAllLEDColor(frame, 255 - frame, 0);
+  frame++;
+
+  // Stop after 256 frames
+  if (frame == 0) {
+    PCA9622::setTrace(nullptr);
+    while (true);
+  }
+  delay(20);
+}
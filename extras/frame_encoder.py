@@ -0,0 +1,268 @@
+#!/usr/bin/env python3
+"""
+Encodes a light show into the compact frame format played by PCA9622FramePlayer.
+
+Usage:
+    frame_encoder.py show.csv --devices 2 -o show.h         PROGMEM header for a sketch
+    frame_encoder.py show.bin --devices 4 --binary -o show.pf
+    frame_encoder.py --demo --devices 2 -o show.h           The show of the FramePlayback example
+
+Input is one frame per line (CSV, decimal or 0x hex values) or per block of bytes (any other file).
+A frame holds --registers values for every device, starting at --first-register (default the 16 PWM registers).
+Every frame only holds the registers that changed since the previous frame, the first frame holds all registers so a show can be rewound.
+Changed registers with small gaps in between are merged into a single span, runs of equal values are stored as a single value.
+Frames that do not change extend the hold time of the previous frame.
+
+The encoded show is decoded again and compared with the input before it is written,
+the compression and the I2C traffic per frame are printed to stderr.
+
+Show format (see PCA9622FramePlayer.h):
+    'P', 'F', version, device count, frame period in ms (16 bit little endian),
+    show length in bytes including the header (32 bit little endian)
+    0x00            end of the show
+    0x01 d          following spans are for device d, every frame starts at device 0
+    0x40 | (n - 1)  literal span: start register, n values
+    0x80 | (n - 1)  run: start register, value written to n registers
+    0xC0 | (n - 1)  end of the frame, show it for n frame periods
+"""
+
+import argparse
+import math
+import sys
+
+FRAME_VERSION = 2
+HEADER_SIZE = 10
+FRAME_END = 0x00
+FRAME_DEVICE = 0x01
+FRAME_LITERAL = 0x40
+FRAME_RUN = 0x80
+FRAME_HOLD = 0xC0
+MAX_COUNT = 64
+REGISTER_COUNT = 0x1C
+PWM0 = 0x02
+
+
+def read_frames(path, devices, registers):
+    size = devices * registers
+    if path.lower().endswith(".csv"):
+        frames = []
+        with open(path) as file:
+            for number, line in enumerate(file, 1):
+                line = line.split("#")[0].strip()
+                if not line:
+                    continue
+                values = [int(value, 0) for value in line.replace(";", ",").split(",") if value.strip()]
+                if len(values) != size or any(value < 0 or value > 255 for value in values):
+                    raise ValueError("line %d: expected %d values from 0 to 255" % (number, size))
+                frames.append(values)
+        return frames
+    with open(path, "rb") as file:
+        data = file.read()
+    if len(data) % size:
+        raise ValueError("%d bytes is not a multiple of the frame size of %d bytes" % (len(data), size))
+    return [list(data[i:i + size]) for i in range(0, len(data), size)]
+
+
+def demo_frames(devices, registers, count=240):
+    """A chase with a fading tail over all outputs, followed by all outputs breathing"""
+    outputs = devices * registers
+    frames = []
+    for frame in range(count // 2):
+        head = (frame // 2) % outputs
+        values = [0] * outputs
+        for tail in range(6):
+            values[(head - tail) % outputs] = 255 >> tail
+        frames.append(values)
+    for frame in range(count - count // 2):
+        level = int(127.5 - 127.5 * math.cos(2 * math.pi * frame / 60))
+        frames.append([level] * outputs)
+    return frames
+
+
+def spans(previous, current, gap):
+    """Start and end (exclusive) of the changed registers, merged when at most gap registers in between did not change"""
+    result = []
+    for index, value in enumerate(current):
+        if previous is not None and previous[index] == value:
+            continue
+        if result and index - result[-1][1] <= gap:
+            result[-1][1] = index + 1
+        else:
+            result.append([index, index + 1])
+    return result
+
+
+def encode_span(output, values, start, end, first_register, min_run):
+    index = start
+    while index < end:
+        run = 1
+        while index + run < end and values[index + run] == values[index]:
+            run += 1
+        if run >= min_run:
+            output += [FRAME_RUN | (run - 1), first_register + index, values[index]]
+            index += run
+            continue
+        literal = index  # Literal up to the next long run
+        while index < end:
+            run = 1
+            while index + run < end and values[index + run] == values[index]:
+                run += 1
+            if run >= min_run:
+                break
+            index += run
+        output += [FRAME_LITERAL | (index - literal - 1), first_register + literal] + values[literal:index]
+
+
+def encode(frames, devices, registers, first_register, period, gap, min_run):
+    output = [ord("P"), ord("F"), FRAME_VERSION, devices, period & 0xFF, period >> 8, 0, 0, 0, 0]
+    previous = None
+    frame = 0
+    while frame < len(frames):
+        current = frames[frame]
+        device_index = 0
+        for device in range(devices):
+            values = current[device * registers:(device + 1) * registers]
+            last = previous[device * registers:(device + 1) * registers] if previous else None
+            changed = spans(last, values, gap)
+            if changed and device != device_index:
+                output += [FRAME_DEVICE, device]
+                device_index = device
+            for start, end in changed:
+                encode_span(output, values, start, end, first_register, min_run)
+        hold = 1
+        while frame + hold < len(frames) and frames[frame + hold] == current:
+            hold += 1
+        remaining = hold
+        while remaining > 0:
+            output.append(FRAME_HOLD | (min(remaining, MAX_COUNT) - 1))
+            remaining -= MAX_COUNT
+        previous = current
+        frame += hold
+    output.append(FRAME_END)
+    output[6:HEADER_SIZE] = list(len(output).to_bytes(4, "little"))
+    return bytes(output)
+
+
+def decode(show, registers, first_register):
+    """Decodes a show like the player does. Returns the frames and the I2C writes (bytes per write) of every frame"""
+    if show[:2] != b"PF" or show[2] != FRAME_VERSION:
+        raise ValueError("not a version %d show" % FRAME_VERSION)
+    length = int.from_bytes(show[6:HEADER_SIZE], "little")
+    if length != len(show):
+        raise ValueError("show length %d in the header, %d bytes encoded" % (length, len(show)))
+    devices = show[3]
+    state = [[0] * REGISTER_COUNT for _ in range(devices)]
+    frames = []
+    writes = []
+    frame_writes = []
+    device = 0
+    position = HEADER_SIZE
+    while True:
+        command = show[position]
+        count = (command & 0x3F) + 1
+        position += 1
+        kind = command & 0xC0
+        if kind == FRAME_HOLD:
+            values = []
+            for registers_of_device in state:
+                values += registers_of_device[first_register:first_register + registers]
+            frames += [values] * count
+            writes += [frame_writes] + [[]] * (count - 1)
+            frame_writes = []
+            device = 0
+        elif kind == FRAME_RUN:
+            start, value = show[position], show[position + 1]
+            position += 2
+            state[device][start:start + count] = [value] * count
+            frame_writes.append(count)
+        elif kind == FRAME_LITERAL:
+            start = show[position]
+            state[device][start:start + count] = list(show[position + 1:position + 1 + count])
+            position += 1 + count
+            frame_writes.append(count)
+        elif command == FRAME_DEVICE:
+            device = show[position]
+            position += 1
+        elif command == FRAME_END:
+            return frames, writes
+        else:
+            raise ValueError("unknown command 0x%02X at %d" % (command, position - 1))
+
+
+def write_header(file, show, name, frames, devices, registers, first_register, period):
+    raw = len(frames) * devices * registers
+    file.write("// Generated by extras/frame_encoder.py: %d frames, %d devices, %d registers from 0x%02X, %d ms per frame\n"
+               % (len(frames), devices, registers, first_register, period))
+    file.write("// %d bytes raw, %d bytes encoded (%.1f:1)\n" % (raw, len(show), raw / len(show)))
+    file.write("#include <Arduino.h>\n\n")
+    file.write("#define %s_FRAMES %d\n" % (name.upper(), len(frames)))
+    file.write("#define %s_RAW_SIZE %d\n\n" % (name.upper(), raw))
+    file.write("const uint8_t %s[] PROGMEM = {\n" % name)
+    for i in range(0, len(show), 16):
+        file.write("    " + ", ".join("0x%02X" % value for value in show[i:i + 16]) + ",\n")
+    file.write("};\n")
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Encode a light show for PCA9622FramePlayer")
+    parser.add_argument("input", nargs="?", help="CSV (one frame per line) or binary frames")
+    parser.add_argument("--demo", action="store_true", help="encode the show of the FramePlayback example instead of an input")
+    parser.add_argument("--devices", type=int, default=1, help="devices per frame (default 1)")
+    parser.add_argument("--registers", type=int, default=16, help="registers per device in a frame (default 16)")
+    parser.add_argument("--first-register", type=lambda value: int(value, 0), default=PWM0, metavar="REG",
+                        help="first register of a frame (default 0x02, PWM0)")
+    parser.add_argument("--period", type=int, default=20, metavar="MS", help="frame period in ms (default 20)")
+    parser.add_argument("--gap", type=int, default=2, help="unchanged registers that are written to merge two spans (default 2)")
+    parser.add_argument("--min-run", type=int, default=4, help="shortest run of equal values that is stored as a run (default 4)")
+    parser.add_argument("--name", default="show", help="name of the array in the header (default show)")
+    parser.add_argument("--binary", action="store_true", help="write the show as binary instead of a header")
+    parser.add_argument("-o", "--output", help="output file (default stdout for a header)")
+    args = parser.parse_args()
+
+    if args.demo == (args.input is not None):
+        parser.error("give an input or --demo")
+    if not 1 <= args.devices <= 255:
+        parser.error("--devices must be 1..255")
+    if args.registers < 1 or args.first_register < 0 or args.first_register + args.registers > REGISTER_COUNT:
+        parser.error("the registers of a frame must be within 0x00..0x1B")
+    if not 0 <= args.period <= 0xFFFF:
+        parser.error("--period must be 0..65535")
+    if args.binary and not args.output:
+        parser.error("--binary needs an output file")
+
+    try:
+        if args.demo:
+            frames = demo_frames(args.devices, args.registers)
+        else:
+            frames = read_frames(args.input, args.devices, args.registers)
+    except (OSError, ValueError) as error:
+        sys.exit("%s: %s" % (args.input, error))
+    if not frames:
+        sys.exit("no frames")
+
+    show = encode(frames, args.devices, args.registers, args.first_register, args.period, max(args.gap, 0), max(args.min_run, 2))
+    decoded, writes = decode(show, args.registers, args.first_register)
+    if decoded != frames:
+        sys.exit("decoded show does not match the input")
+
+    raw = len(frames) * args.devices * args.registers
+    bus_full = len(frames) * args.devices * (2 + args.registers)  # Full refresh: address, register and all data per device
+    bus_delta = sum(2 + count for frame in writes for count in frame)
+    transactions = sum(len(frame) for frame in writes)
+    sys.stderr.write("%d frames of %d ms, %d devices x %d registers\n" % (len(frames), args.period, args.devices, args.registers))
+    sys.stderr.write("size: %d bytes raw, %d bytes encoded, ratio %.1f:1\n" % (raw, len(show), raw / len(show)))
+    sys.stderr.write("bus:  %.1f writes, %.1f bytes per frame (full refresh %.1f bytes)\n"
+                     % (transactions / len(frames), bus_delta / len(frames), bus_full / len(frames)))
+
+    if args.binary:
+        with open(args.output, "wb") as file:
+            file.write(show)
+    elif args.output:
+        with open(args.output, "w") as file:
+            write_header(file, show, args.name, frames, args.devices, args.registers, args.first_register, args.period)
+    else:
+        write_header(sys.stdout, show, args.name, frames, args.devices, args.registers, args.first_register, args.period)
+
+
+if __name__ == "__main__":
+    main()
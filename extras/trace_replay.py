@@ -0,0 +1,392 @@
+#!/usr/bin/env python3
+"""
+Replays an I2C trace recorded with PCA9622::setTrace on a model of the PCA9622.
+
+Usage:
+    trace_replay.py trace.bin                 Bus cost and final output state
+    trace_replay.py trace.bin --frames        Output state after every frame
+    trace_replay.py trace.bin --dump          Every recorded transaction
+    trace_replay.py old.bin new.bin           Compares the bus cost and output state of two traces
+
+A frame is a group of transactions without a pause longer than --frame-gap in between.
+The output state is the duty cycle of all 16 outputs of every device as set by LEDOUT, PWM, GRPPWM, SLEEP and the PWM on the OE pin.
+Blinking outputs are shown with their PWM value. Version 1 traces do not contain the OE pin, the outputs are assumed to be enabled.
+Devices are identified by their bus and address, so devices with the same address on different buses are kept apart.
+Version 1 and 2 traces do not contain the bus, all their transactions are on bus 0.
+
+Trace format (see I2C_coms.h):
+    'P', 'T', version
+    per transaction: flags, delta time (varint), duration (varint), bus (version 3), device address, register address,
+                     length (varint), data
+    flags bit 0: read, bit 1: output enable change with the duty cycle as data (no I2C traffic), bit 7:4: result
+    bus 0 is Wire, other buses are numbered in the order of their first record, 0xFF is a bus beyond the first 4
+"""
+
+import argparse
+import sys
+
+TRACE_VERSIONS = (1, 2, 3)
+TRACE_BUS_VERSION = 3
+TRACE_READ = 0x01
+TRACE_OUTPUT_ENABLE = 0x02
+
+# Registers
+MODE1 = 0x00
+MODE2 = 0x01
+PWM0 = 0x02
+GRPPWM = 0x12
+GRPFREQ = 0x13
+LEDOUT0 = 0x14
+SUBADR1 = 0x18
+SUBADR2 = 0x19
+SUBADR3 = 0x1A
+ALLCALLADR = 0x1B
+REGISTER_COUNT = 0x1C
+
+SW_RESET_ADDRESS = 0x06
+SLEEP = 0x10
+DMBLNK = 0x20
+
+# Auto increment ranges per AI[2:0] (first, last)
+AUTO_INCREMENT = {
+    0x80: (MODE1, ALLCALLADR),
+    0xA0: (PWM0, PWM0 + 15),
+    0xC0: (GRPPWM, GRPFREQ),
+    0xE0: (PWM0, GRPFREQ),
+}
+
+
+class Transaction:
+    def __init__(self, time, duration, flags, bus, address, register, data):
+        self.time = time
+        self.duration = duration
+        self.bus = bus
+        self.read = bool(flags & TRACE_READ)
+        self.output_enable = bool(flags & TRACE_OUTPUT_ENABLE)
+        self.result = flags >> 4
+        self.address = address
+        self.register = register
+        self.data = data
+
+    def bus_bytes(self):
+        """Bytes on the bus including the device address and control register"""
+        if self.output_enable:
+            return 0
+        if self.result == 2:
+            return 1  # NACK on the device address
+        if self.read:
+            return 3 + len(self.data)  # Address, control register, repeated start address and data
+        return 2 + len(self.data)
+
+    def __str__(self):
+        if self.output_enable:
+            return "%10d us          OE %s duty %d" % (self.time, format_device((self.bus, self.address)),
+                                                       self.data[0] if self.data else 0xFF)
+        kind = "R" if self.read else "W"
+        data = " ".join("%02X" % d for d in self.data)
+        result = "" if self.result == 0 else " error %d" % self.result
+        return "%10d us %5d us %s %s [0x%02X] %s%s" % (self.time, self.duration, kind, format_device((self.bus, self.address)),
+                                                   self.register, data, result)
+
+
+def format_device(key):
+    bus, address = key
+    return "bus %d 0x%02X" % (bus, address)
+
+
+def read_varint(data, pos):
+    value = 0
+    shift = 0
+    while True:
+        byte = data[pos]
+        pos += 1
+        value |= (byte & 0x7F) << shift
+        shift += 7
+        if not byte & 0x80:
+            return value, pos
+
+
+def parse_trace(path):
+    with open(path, "rb") as f:
+        data = f.read()
+    if len(data) < 3 or data[0:2] != b"PT":
+        raise ValueError("%s is not a PCA9622 trace" % path)
+    if data[2] not in TRACE_VERSIONS:
+        raise ValueError("%s has unsupported trace version %d" % (path, data[2]))
+
+    has_bus = data[2] >= TRACE_BUS_VERSION
+    transactions = []
+    pos = 3
+    time = 0
+    try:
+        while pos < len(data):
+            flags = data[pos]
+            delta, pos = read_varint(data, pos + 1)
+            duration, pos = read_varint(data, pos)
+            bus = 0
+            if has_bus:
+                bus = data[pos]
+                pos += 1
+            address = data[pos]
+            register = data[pos + 1]
+            length, pos = read_varint(data, pos + 2)
+            if pos + length > len(data):
+                raise IndexError
+            payload = bytes(data[pos:pos + length])
+            pos += length
+            time += delta
+            transactions.append(Transaction(time, duration, flags, bus, address, register, payload))
+    except IndexError:
+        print("warning: %s ends with an incomplete record" % path, file=sys.stderr)
+    return transactions
+
+
+class Device:
+    def __init__(self, address):
+        self.address = address
+        self.output_enable = 0xFF  # The OE pin is not part of the device registers and survives a reset
+        self.reset()
+
+    def reset(self):
+        self.registers = [0] * REGISTER_COUNT
+        self.registers[MODE1] = 0x91
+        self.registers[MODE2] = 0x05
+        self.registers[GRPPWM] = 0xFF
+        self.registers[SUBADR1] = 0xE2
+        self.registers[SUBADR2] = 0xE4
+        self.registers[SUBADR3] = 0xE8
+        self.registers[ALLCALLADR] = 0xE0
+        self.redundant = 0
+
+    def responds_to(self, address):
+        mode1 = self.registers[MODE1]
+        return (address == self.address or
+                (mode1 & 0x01 and address == self.registers[ALLCALLADR]) or
+                (mode1 & 0x08 and address == self.registers[SUBADR1]) or
+                (mode1 & 0x04 and address == self.registers[SUBADR2]) or
+                (mode1 & 0x02 and address == self.registers[SUBADR3]))
+
+    @staticmethod
+    def next_register(control, register):
+        increment = control & 0xE0
+        if increment == 0x00:
+            return register
+        first, last = AUTO_INCREMENT.get(increment, (MODE1, ALLCALLADR))
+        if register == last:
+            return first
+        return (register + 1) % REGISTER_COUNT
+
+    def write(self, control, data):
+        register = control & 0x1F
+        for value in data:
+            if register == MODE1:
+                value = (value & 0x1F) | (control & 0xE0)  # AI[2:0] are read only
+            if register < REGISTER_COUNT:
+                if self.registers[register] == value:
+                    self.redundant += 1
+                self.registers[register] = value
+            register = self.next_register(control, register)
+        self.registers[MODE1] = (self.registers[MODE1] & 0x1F) | (control & 0xE0)
+
+    def outputs(self):
+        mode1 = self.registers[MODE1]
+        state = []
+        for output in range(16):
+            mode = (self.registers[LEDOUT0 + output // 4] >> ((output % 4) * 2)) & 0x03
+            pwm = self.registers[PWM0 + output]
+            if mode == 0:
+                state.append(0)
+            elif mode == 1:
+                state.append(255)
+            elif mode1 & SLEEP:
+                state.append(0)  # The PWM needs the oscillator
+            elif mode == 2 or self.registers[MODE2] & DMBLNK:
+                state.append(pwm)
+            else:
+                state.append((pwm * self.registers[GRPPWM]) >> 8)
+        if self.output_enable != 0xFF:
+            # PWM on OE gates all outputs, including the outputs that are fully on
+            state = [(value * self.output_enable) >> 8 for value in state]
+        return tuple(state)
+
+
+class Replay:
+    def __init__(self, transactions, frame_gap, clock, devices):
+        self.transactions = transactions
+        self.devices = {}  # (bus, address): Device
+        self.frames = []  # (time, transactions, state)
+        self.redundant = 0
+        self.clock = clock
+        for key in devices:
+            self.devices[key] = Device(key[1])
+        self.run(frame_gap)
+
+    def device(self, bus, address):
+        key = (bus, address)
+        if key not in self.devices:
+            self.devices[key] = Device(address)
+        return self.devices[key]
+
+    def targets(self, bus, address):
+        targets = [d for (b, _), d in self.devices.items() if b == bus and d.responds_to(address)]
+        if not targets and address != SW_RESET_ADDRESS:
+            # First transaction to a device address that is not a known broadcast address
+            targets = [self.device(bus, address)]
+        return targets
+
+    def apply(self, transaction):
+        if transaction.output_enable:
+            self.device(transaction.bus, transaction.address).output_enable = transaction.data[0] if transaction.data else 0xFF
+            return
+        if transaction.result != 0 and transaction.result != 3:
+            return
+        if transaction.address == SW_RESET_ADDRESS:
+            if not transaction.read and transaction.register == 0xA5 and transaction.data == b"\x5a":
+                # The software reset only reaches the devices on its own bus
+                for (bus, _), device in self.devices.items():
+                    if bus == transaction.bus:
+                        self.redundant += device.redundant
+                        device.reset()
+            return
+        for device in self.targets(transaction.bus, transaction.address):
+            if transaction.read:
+                device.registers[MODE1] = (device.registers[MODE1] & 0x1F) | (transaction.register & 0xE0)
+            else:
+                device.write(transaction.register, transaction.data)
+
+    def state(self):
+        return tuple((key, self.devices[key].outputs()) for key in sorted(self.devices))
+
+    def run(self, frame_gap):
+        frame_start = None
+        frame_count = 0
+        last_end = None
+        for transaction in self.transactions:
+            if last_end is not None and transaction.time - last_end > frame_gap:
+                self.frames.append((frame_start, frame_count, self.state()))
+                frame_start = None
+            if frame_start is None:
+                frame_start = transaction.time
+                frame_count = 0
+            self.apply(transaction)
+            frame_count += 1
+            last_end = transaction.time + transaction.duration
+        if frame_start is not None:
+            self.frames.append((frame_start, frame_count, self.state()))
+        self.redundant += sum(device.redundant for device in self.devices.values())
+
+    def cost(self):
+        bus = [t for t in self.transactions if not t.output_enable]
+        transactions = len(bus)
+        reads = sum(1 for t in bus if t.read)
+        errors = sum(1 for t in bus if t.result != 0)
+        total_bytes = sum(t.bus_bytes() for t in bus)
+        # 9 clocks per byte, start and stop condition and a repeated start for reads
+        clocks = total_bytes * 9 + transactions * 2 + reads
+        duration = sum(t.duration for t in bus)
+        span = self.transactions[-1].time if self.transactions else 0
+        return [
+            ("transactions", transactions),
+            ("output enable changes", len(self.transactions) - transactions),
+            ("reads", reads),
+            ("errors", errors),
+            ("bytes", total_bytes),
+            ("redundant writes", self.redundant),
+            ("frames", len(self.frames)),
+            ("bus time estimate (us)", clocks * 1000000 // self.clock),
+            ("measured time (us)", duration),
+            ("trace span (us)", span),
+        ]
+
+    def output_sequence(self):
+        """The output states without repetitions, independent of how the writes are grouped in frames"""
+        sequence = []
+        for _, _, state in self.frames:
+            if not sequence or sequence[-1] != state:
+                sequence.append(state)
+        return sequence
+
+
+def format_state(state):
+    lines = []
+    for key, outputs in state:
+        lines.append("  %s: %s" % (format_device(key), " ".join("%02X" % o for o in outputs)))
+    return "\n".join(lines)
+
+
+def print_cost(replay):
+    for name, value in replay.cost():
+        print("%-24s %10d" % (name, value))
+
+
+def compare(old, new):
+    print("%-24s %10s %10s %8s" % ("", "old", "new", "change"))
+    for (name, a), (_, b) in zip(old.cost(), new.cost()):
+        change = "" if a == 0 else "%+7.1f%%" % ((b - a) * 100.0 / a)
+        print("%-24s %10d %10d %8s" % (name, a, b, change))
+
+    old_sequence = old.output_sequence()
+    new_sequence = new.output_sequence()
+    for index, (a, b) in enumerate(zip(old_sequence, new_sequence)):
+        if a != b:
+            print("\nOutput state %d differs" % index)
+            print("old:\n" + format_state(a))
+            print("new:\n" + format_state(b))
+            return False
+    if len(old_sequence) != len(new_sequence):
+        print("\nOld trace has %d output states, new trace has %d" % (len(old_sequence), len(new_sequence)))
+        return False
+    print("\nOutput states are identical (%d states)" % len(old_sequence))
+    return True
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Replay PCA9622 I2C traces and compare their bus cost")
+    parser.add_argument("traces", nargs="+", metavar="trace", help="one trace to replay or two traces to compare")
+    parser.add_argument("--frames", action="store_true", help="print the output state after every frame")
+    parser.add_argument("--dump", action="store_true", help="print every transaction")
+    parser.add_argument("--frame-gap", type=int, default=2000, metavar="US", help="pause in us that ends a frame (default 2000)")
+    parser.add_argument("--clock", type=int, default=400000, metavar="HZ", help="I2C clock for the bus time estimate (default 400000)")
+    parser.add_argument("--device", action="append", default=[], metavar="[BUS:]ADDR",
+                        help="8 bit device address on bus 0 or the given bus, "
+                             "needed when a device is only written through a broadcast address")
+    args = parser.parse_args()
+
+    if len(args.traces) > 2:
+        parser.error("expected one or two traces")
+    devices = []
+    for device in args.device:
+        bus, _, address = device.rpartition(":")
+        devices.append((int(bus, 0) if bus else 0, int(address, 0)))
+
+    try:
+        replays = []
+        for path in args.traces:
+            transactions = parse_trace(path)
+            if args.dump:
+                print("%s:" % path)
+                for transaction in transactions:
+                    print(transaction)
+            replays.append(Replay(transactions, args.frame_gap, args.clock, devices))
+    except (OSError, ValueError) as e:
+        print("error: %s" % e, file=sys.stderr)
+        return 2
+
+    if len(replays) == 2:
+        return 0 if compare(replays[0], replays[1]) else 1
+
+    replay = replays[0]
+    if args.frames:
+        for index, (time, count, state) in enumerate(replay.frames):
+            print("frame %d at %d us, %d transactions" % (index, time, count))
+            print(format_state(state))
+    elif replay.frames:
+        print("final output state:")
+        print(format_state(replay.frames[-1][2]))
+    print()
+    print_cost(replay)
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
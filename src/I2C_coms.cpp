@@ -12,19 +12,84 @@
 
 //#define I2C_DEBUG
 
+#define I2C_TRACE_VERSION       3
+#define I2C_TRACE_READ          0x01
+#define I2C_TRACE_OUTPUT_ENABLE 0x02
+#define I2C_TRACE_MAX_BUSES     4
+#define I2C_TRACE_UNKNOWN_BUS   0xFF
+
+static Print *trace_output = nullptr;
+static uint32_t trace_last = 0;
+static TwoWire *trace_buses[I2C_TRACE_MAX_BUSES]; // Bus index in the trace, Wire is always 0
+static uint8_t trace_bus_count = 0;
+
+static uint8_t trace_bus(TwoWire *bus) {
+    for (uint8_t index = 0; index < trace_bus_count; index++) {
+        if (trace_buses[index] == bus) return index;
+    }
+    if (trace_bus_count >= I2C_TRACE_MAX_BUSES) return I2C_TRACE_UNKNOWN_BUS;
+    trace_buses[trace_bus_count] = bus;
+    return trace_bus_count++;
+}
+
+static void trace_varint(uint32_t value) {
+    do {
+        uint8_t data = value & 0x7F;
+        value >>= 7;
+        if (value) data |= 0x80;
+        trace_output->write(data);
+    } while (value);
+}
+
+static void trace_record(uint8_t flags, int8_t result, uint32_t start, TwoWire *bus, uint8_t deviceAddress, uint8_t registerAddress, const uint8_t *pattern, uint32_t patternLength, uint32_t count) {
+    uint32_t duration = micros() - start;
+    trace_output->write((uint8_t)(flags | ((result & 0x0F) << 4)));
+    trace_varint(start - trace_last);
+    trace_varint(duration);
+    trace_output->write(trace_bus(bus));
+    trace_output->write(deviceAddress);
+    trace_output->write(registerAddress);
+    trace_varint(count);
+    uint32_t index = 0;
+    while (count--) {
+        trace_output->write(pattern[index]);
+        if (++index >= patternLength) index = 0;
+    }
+    trace_last = start;
+}
+
+void i2c_set_trace(Print *output) {
+    trace_output = output;
+    trace_last = micros();
+    trace_buses[0] = &Wire;
+    trace_bus_count = 1;
+    if (output) {
+        output->write('P');
+        output->write('T');
+        output->write((uint8_t)I2C_TRACE_VERSION);
+    }
+}
+
+void i2c_trace_output_enable(TwoWire *bus, uint8_t deviceAddress, uint8_t duty) {
+    if (trace_output) trace_record(I2C_TRACE_OUTPUT_ENABLE, 0, micros(), bus, deviceAddress, 0, &duty, 1, 1);
+}
+
 int8_t i2c_init() {
     //Wire.begin(); Best to pull this out of the library
     return 0;
 }
 
-int8_t i2c_write_multi(uint8_t deviceAddress, uint8_t registerAddress, uint8_t *pdata, uint32_t count) {
-    Wire.beginTransmission(((deviceAddress) >> 1) & 0x7F);
-    Wire.write(registerAddress);
+int8_t i2c_write_multi(TwoWire *bus, uint8_t deviceAddress, uint8_t registerAddress, uint8_t *pdata, uint32_t count) {
+    uint32_t start = micros();
+    const uint8_t *data = pdata;
+    uint32_t length = count;
+    bus->beginTransmission(((deviceAddress) >> 1) & 0x7F);
+    bus->write(registerAddress);
 #ifdef I2C_DEBUG
     Serial.print("\tWriting "); Serial.print(count); Serial.print(" to addr 0x"); Serial.print(registerAddress, HEX); Serial.print(": ");
 #endif
     while(count--) {
-        Wire.write((uint8_t)pdata[0]);
+        bus->write((uint8_t)pdata[0]);
 #ifdef I2C_DEBUG
         Serial.print("0x"); Serial.print(pdata[0], HEX); Serial.print(", ");
 #endif
@@ -33,20 +98,53 @@ int8_t i2c_write_multi(uint8_t deviceAddress, uint8_t registerAddress, uint8_t *
 #ifdef I2C_DEBUG
     Serial.println();
 #endif
-    return Wire.endTransmission();
+    int8_t retVal = bus->endTransmission();
+    if (trace_output) trace_record(0, retVal, start, bus, deviceAddress, registerAddress, data, length, length);
+    return retVal;
+}
+
+int8_t i2c_write_pattern(TwoWire *bus, uint8_t deviceAddress, uint8_t registerAddress, const uint8_t *pattern, uint8_t patternLength, uint32_t count) {
+    uint32_t start = micros();
+    uint32_t length = count;
+    bus->beginTransmission(((deviceAddress) >> 1) & 0x7F);
+    bus->write(registerAddress);
+#ifdef I2C_DEBUG
+    Serial.print("\tWriting "); Serial.print(count); Serial.print(" to addr 0x"); Serial.print(registerAddress, HEX); Serial.print(" repeating: ");
+    for (uint8_t i = 0; i < patternLength; i++) {
+        Serial.print("0x"); Serial.print(pattern[i], HEX); Serial.print(", ");
+    }
+    Serial.println();
+#endif
+    uint8_t index = 0;
+    while(count--) {
+        bus->write(pattern[index]);
+        if (++index >= patternLength) index = 0;
+    }
+    int8_t retVal = bus->endTransmission();
+    if (trace_output) trace_record(0, retVal, start, bus, deviceAddress, registerAddress, pattern, patternLength, length);
+    return retVal;
 }
 
-int8_t i2c_read_multi(uint8_t deviceAddress, uint8_t registerAddress, uint8_t *pdata, uint32_t count){
-    Wire.beginTransmission(((deviceAddress) >> 1) & 0x7F);
-    Wire.write(registerAddress);
-    Wire.endTransmission(false); // Dont send a stop bit
-    Wire.requestFrom(((deviceAddress) >> 1) & 0x7F, count);
+int8_t i2c_read_multi(TwoWire *bus, uint8_t deviceAddress, uint8_t registerAddress, uint8_t *pdata, uint32_t count){
+    uint32_t start = micros();
+    const uint8_t *data = pdata;
+    uint32_t length = count;
+    bus->beginTransmission(((deviceAddress) >> 1) & 0x7F);
+    bus->write(registerAddress);
+    int8_t retVal = bus->endTransmission(false); // Dont send a stop bit
+    if (retVal == 0 && bus->requestFrom(((deviceAddress) >> 1) & 0x7F, count) != count) {
+        retVal = 4;
+    }
+    if (retVal != 0) {
+        if (trace_output) trace_record(I2C_TRACE_READ, retVal, start, bus, deviceAddress, registerAddress, data, 0, 0);
+        return retVal;
+    }
 #ifdef I2C_DEBUG
     Serial.print("\tReading "); Serial.print(count); Serial.print(" from addr 0x"); Serial.print(registerAddress, HEX); Serial.print(": ");
 #endif
 
     while (count--) {
-        pdata[0] = Wire.read();
+        pdata[0] = bus->read();
 #ifdef I2C_DEBUG
         Serial.print("0x"); Serial.print(pdata[0], HEX); Serial.print(", ");
 #endif
@@ -55,21 +153,22 @@ int8_t i2c_read_multi(uint8_t deviceAddress, uint8_t registerAddress, uint8_t *p
 #ifdef I2C_DEBUG
     Serial.println();
 #endif
+    if (trace_output) trace_record(I2C_TRACE_READ, 0, start, bus, deviceAddress, registerAddress, data, length, length);
     return 0;
 }
 
-int8_t i2c_write_byte(uint8_t deviceAddress, uint8_t registerAddress, uint8_t data) {
-    return i2c_write_multi(deviceAddress, registerAddress, &data, 1);
+int8_t i2c_write_byte(TwoWire *bus, uint8_t deviceAddress, uint8_t registerAddress, uint8_t data) {
+    return i2c_write_multi(bus, deviceAddress, registerAddress, &data, 1);
 }
 
-// int8_t i2c_write_word(uint8_t deviceAddress, uint8_t registerAddress, uint16_t data) {
+// int8_t i2c_write_word(TwoWire *bus, uint8_t deviceAddress, uint8_t registerAddress, uint16_t data) {
 //     uint8_t buff[2];
 //     buff[1] = data & 0xFF;
 //     buff[0] = data >> 8;
-//     return i2c_write_multi(deviceAddress, registerAddress, buff, 2);
+//     return i2c_write_multi(bus, deviceAddress, registerAddress, buff, 2);
 // }
 
-// int8_t i2c_write_Dword(uint8_t deviceAddress, uint8_t registerAddress, uint32_t data) {
+// int8_t i2c_write_Dword(TwoWire *bus, uint8_t deviceAddress, uint8_t registerAddress, uint32_t data) {
 //     uint8_t buff[4];
 
 //     buff[3] = data & 0xFF;
@@ -77,16 +176,16 @@ int8_t i2c_write_byte(uint8_t deviceAddress, uint8_t registerAddress, uint8_t da
 //     buff[1] = data >> 16;
 //     buff[0] = data >> 24;
 
-//     return i2c_write_multi(deviceAddress, registerAddress, buff, 4);
+//     return i2c_write_multi(bus, deviceAddress, registerAddress, buff, 4);
 // }
 
-int8_t i2c_read_byte(uint8_t deviceAddress, uint8_t registerAddress, uint8_t *data) {
-    return i2c_read_multi(deviceAddress, registerAddress, data, 1);
+int8_t i2c_read_byte(TwoWire *bus, uint8_t deviceAddress, uint8_t registerAddress, uint8_t *data) {
+    return i2c_read_multi(bus, deviceAddress, registerAddress, data, 1);
 }
 
-// int8_t i2c_read_word(uint8_t deviceAddress, uint8_t registerAddress, uint16_t *data) {
+// int8_t i2c_read_word(TwoWire *bus, uint8_t deviceAddress, uint8_t registerAddress, uint16_t *data) {
 //     uint8_t buff[2];
-//     int r = i2c_read_multi(deviceAddress, registerAddress, buff, 2);
+//     int r = i2c_read_multi(bus, deviceAddress, registerAddress, buff, 2);
 
 //     uint16_t tmp;
 //     tmp = buff[0];
@@ -97,9 +196,9 @@ int8_t i2c_read_byte(uint8_t deviceAddress, uint8_t registerAddress, uint8_t *da
 //     return r;
 // }
 
-// int8_t i2c_read_Dword(uint8_t deviceAddress, uint8_t registerAddress, uint32_t *data) {
+// int8_t i2c_read_Dword(TwoWire *bus, uint8_t deviceAddress, uint8_t registerAddress, uint32_t *data) {
 //     uint8_t buff[4];
-//     int r = i2c_read_multi(deviceAddress, registerAddress, buff, 4);
+//     int r = i2c_read_multi(bus, deviceAddress, registerAddress, buff, 4);
 
 //     uint32_t tmp;
 //     tmp = buff[0];
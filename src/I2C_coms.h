@@ -24,18 +24,49 @@ extern "C"
  */
 int8_t i2c_init();
 
+/** @brief i2c_set_trace() definition.\n
+ * Records every transaction to the output in a compact binary trace. nullptr stops the recording.\n
+ * The trace starts with the bytes 'P', 'T' and the format version 3, followed by a record per transaction:\n
+ * flags (bit 0: read, bit 1: output enable, bit 7:4: result), start time in us since the previous record (varint), duration in us (varint), 
+ * bus, device address, register address, data length (varint) and the written or read data.\n
+ * The bus is 0 for Wire, other buses are numbered in the order of their first record. 0xFF marks a bus beyond the first 4.\n
+ * Varints are little endian with 7 bits per byte, bit 7 is set when more bytes follow
+ */
+void i2c_set_trace(Print *output);
+
+/** @brief i2c_trace_output_enable() definition.\n
+ * Records a change of the ~OE pin of a device in the trace as an output enable record with the duty cycle as data. No I2C traffic
+ */
+void i2c_trace_output_enable(
+        TwoWire      *bus,
+        uint8_t       deviceAddress,
+        uint8_t       duty);
+
 /** @brief i2c_write_multi() definition.\n
  * To be implemented by the developer
  */
 int8_t i2c_write_multi(
+        TwoWire      *bus,
         uint8_t       deviceAddress,
         uint8_t       registerAddress,
         uint8_t      *pdata,
         uint32_t      count);
+/** @brief i2c_write_pattern() definition.\n
+ * To be implemented by the developer. Writes count bytes by repeating the pattern without a buffer
+ */
+int8_t i2c_write_pattern(
+        TwoWire      *bus,
+        uint8_t       deviceAddress,
+        uint8_t       registerAddress,
+        const uint8_t *pattern,
+        uint8_t       patternLength,
+        uint32_t      count);
 /** @brief i2c_read_multi() definition.\n
- * To be implemented by the developer
+ * To be implemented by the developer. Returns 0 on success, the error of the write of the register address, 
+ * or 4 when the device did not return all bytes (for example a broadcast address that acknowledges writes only)
  */
 int8_t i2c_read_multi(
+        TwoWire      *bus,
         uint8_t       deviceAddress,
         uint8_t       registerAddress,
         uint8_t      *pdata,
@@ -44,6 +75,7 @@ int8_t i2c_read_multi(
  * To be implemented by the developer
  */
 int8_t i2c_write_byte(
+        TwoWire      *bus,
         uint8_t       deviceAddress,
         uint8_t       registerAddress,
         uint8_t       data);
@@ -51,6 +83,7 @@ int8_t i2c_write_byte(
 //  * To be implemented by the developer
 //  */
 // int8_t i2c_write_word(
+//         TwoWire      *bus,
 //         uint8_t       deviceAddress,
 //         uint8_t       registerAddress,
 //         uint16_t      data);
@@ -58,6 +91,7 @@ int8_t i2c_write_byte(
 //  * To be implemented by the developer
 //  */
 // int8_t i2c_write_Dword(
+//         TwoWire      *bus,
 //         uint8_t       deviceAddress,
 //         uint8_t      registerAddress,
 //         uint32_t      data);
@@ -65,6 +99,7 @@ int8_t i2c_write_byte(
  * To be implemented by the developer
  */
 int8_t i2c_read_byte(
+        TwoWire      *bus,
         uint8_t       deviceAddress,
         uint8_t       registerAddress,
         uint8_t      *pdata);
@@ -72,6 +107,7 @@ int8_t i2c_read_byte(
 //  * To be implemented by the developer
 //  */
 // int8_t i2c_read_word(
+//         TwoWire      *bus,
 //         uint8_t       deviceAddress,
 //         uint8_t       registerAddress,
 //         uint16_t     *pdata);
@@ -79,6 +115,7 @@ int8_t i2c_read_byte(
 //  * To be implemented by the developer
 //  */
 // int8_t i2c_read_Dword(
+//         TwoWire      *bus,
 //         uint8_t       deviceAddress,
 //         uint8_t       registerAddress,
 //         uint32_t     *pdata);
@@ -11,8 +11,65 @@
 #include "PCA9622.h"
 #include "I2C_coms.h"
 
+#ifndef PCA9622_LOW_FOOTPRINT
+// Steps of the asynchronous sequences
+enum EAsyncState {
+    Idle,
+    BeginReadMode,
+    BeginWakeUp,
+    BeginOutputState,
+    ReadMode,
+    WakeUp,
+    WaitWakeUp,
+    Reset,
+    WaitReset
+};
+#endif
+
+#ifdef PCA9622_LOW_FOOTPRINT
+uint8_t PCA9622::_i2c_address_all_call = PCA9622_I2C_ALL_CALL;
+uint8_t PCA9622::_i2c_address_sub_1 = PCA9622_I2C_SUB_1;
+uint8_t PCA9622::_i2c_address_sub_2 = PCA9622_I2C_SUB_2;
+uint8_t PCA9622::_i2c_address_sub_3 = PCA9622_I2C_SUB_3;
+#endif
+
+// RGB values of the black body color temperature from PCA9622_KELVIN_MIN in steps of 512K
+static const uint8_t kelvinTable[] PROGMEM = {
+    255,  68,   0, // 1000K
+    255, 109,   0, // 1512K
+    255, 138,  17, // 2024K
+    255, 160,  73, // 2536K
+    255, 179, 113, // 3048K
+    255, 194, 144, // 3560K
+    255, 208, 169, // 4072K
+    255, 219, 191, // 4584K
+    255, 230, 209, // 5096K
+    255, 239, 226, // 5608K
+    255, 248, 240, // 6120K
+    255, 251, 255, // 6632K
+    238, 240, 255, // 7144K
+    227, 233, 255, // 7656K
+    219, 228, 255, // 8168K
+    213, 225, 255, // 8680K
+    208, 222, 255, // 9192K
+    204, 219, 255, // 9704K
+    200, 217, 255, // 10216K
+    197, 215, 255, // 10728K
+    195, 214, 255, // 11240K
+    192, 212, 255, // 11752K
+    190, 211, 255, // 12264K
+};
+
 /*----------------------- Initialisation functions --------------------------*/
 
+/**
+ * @brief This function instantiates the class object without an I2C address. 
+ * Set the address with @ref setI2CAddress or use @ref scan to fill an array of these objects
+ * 
+ */
+PCA9622::PCA9622() {
+}
+
 /**
  * @brief This function instantiates the class object
  * 
@@ -55,21 +112,99 @@ void PCA9622::begin() {
         pinMode(_OE_pin, OUTPUT);
     }
     disableOutputs();
+#ifndef PCA9622_LOW_FOOTPRINT
+    if (_asleep) _sleep_since = millis(); // The time before begin is not counted as sleep time
+#endif
 
     wakeUp();
     // Set all outputs to PWM_AND_GROUP_CONTROL
-    uint8_t buffer[] = {0xFF, 0xFF, 0xFF, 0xFF};
-    writeMultiRegister(PCA9622_LED_OUT0 | PCA9622_AI_ALL, buffer, 4); // Sets the led output state
+    writeRepeatRegister(PCA9622_LED_OUT0 | PCA9622_AI_ALL, 0xFF, 4); // Sets the led output state
 }
 
 /**
- * @brief Resets the PCA9622 @warning resets all PCA9622 devices on the I2C Bus! @note the PCA9266 resets in low power mode so make sure to call @ref wakeUp to power up the device
+ * @brief Resets the PCA9622 @warning resets all PCA9622 devices on the I2C Bus of this device! @note the PCA9266 resets in low power mode so make sure to call @ref wakeUp to power up the device
  * 
  */
 void PCA9622::softwareReset() {
-    i2c_write_byte(PCA9622_I2C_SW_RESET, 0xA5, 0x5A);
+    i2c_write_byte(_wire, PCA9622_I2C_SW_RESET, 0xA5, 0x5A);
+#ifndef PCA9622_LOW_FOOTPRINT
+    resetShadow();
+#endif
     // Wait a few microseconds for the reset to complete. Ready after the specified bus free time. (100kHz: 4.7us, 400kHz: 1.3us, 1MHz: 0.5us)
-    delayMicroseconds(20);
+    delayMicroseconds(PCA9622_RESET_TIME_US);
+}
+
+
+/*----------------------- Discovery functions -------------------------------*/
+
+/**
+ * @brief Checks if a PCA9622 responds on the given address. 
+ * Reads MODE1 and MODE2 in a single transaction and checks the read only and reserved bits
+ * 
+ * @param i2c_address The I2C address to probe
+ * @param bus The I2C bus to probe on
+ * @return true A PCA9622 responded
+ * @return false No device or another type of device responded
+ */
+bool PCA9622::probe(uint8_t i2c_address, TwoWire *bus) {
+    uint8_t buffer[2];
+    if (i2c_read_multi(bus, i2c_address, PCA9622_MODE1 | PCA9622_AI_ALL, buffer, 2) != 0) {
+        return false;
+    }
+    // AI[2:0] in MODE1 reflect the control register (100 for PCA9622_AI_ALL)
+    // MODE2 bits 7 and 6 are read only 0 and bits 2..0 are reserved 101
+    return ((buffer[0] & 0xE0) == 0x80) && ((buffer[1] & 0xC7) == 0x05);
+}
+
+/**
+ * @brief Scans the I2C bus for PCA9622 devices. 
+ * Probes all addresses from @ref PCA9622_I2C_FIRST_ADDRESS to @ref PCA9622_I2C_LAST_ADDRESS and skips the default AllCall and SubCall addresses. 
+ * Every address costs a single transaction, addresses without a device are only addressed and released
+ * 
+ * @param addresses The buffer to store the found addresses in
+ * @param maxCount The size of the buffer. The scan stops when the buffer is full
+ * @param duration Optional. Set to the duration of the scan in us
+ * @param bus The I2C bus to scan
+ * @return uint8_t The amount of devices found
+ */
+uint8_t PCA9622::scan(uint8_t *addresses, uint8_t maxCount, uint32_t *duration, TwoWire *bus) {
+    uint32_t start = micros();
+    uint8_t found = 0;
+    for (uint8_t address = PCA9622_I2C_FIRST_ADDRESS; address <= PCA9622_I2C_LAST_ADDRESS && found < maxCount; address += 2) {
+        if (isReservedAddress(address)) continue;
+        if (probe(address, bus)) {
+            addresses[found++] = address;
+        }
+    }
+    if (duration != nullptr) {
+        *duration = micros() - start;
+    }
+    return found;
+}
+
+/**
+ * @brief Scans the I2C bus for PCA9622 devices and sets the address and bus of the given device objects. See @ref scan
+ * 
+ * @param devices The device objects to assign the found addresses to
+ * @param maxCount The amount of device objects. The scan stops when all objects have an address
+ * @param duration Optional. Set to the duration of the scan in us
+ * @param bus The I2C bus to scan
+ * @return uint8_t The amount of devices found
+ */
+uint8_t PCA9622::scan(PCA9622 *devices, uint8_t maxCount, uint32_t *duration, TwoWire *bus) {
+    uint32_t start = micros();
+    uint8_t found = 0;
+    for (uint8_t address = PCA9622_I2C_FIRST_ADDRESS; address <= PCA9622_I2C_LAST_ADDRESS && found < maxCount; address += 2) {
+        if (isReservedAddress(address)) continue;
+        if (probe(address, bus)) {
+            devices[found].setBus(bus);
+            devices[found++].setI2CAddress(address);
+        }
+    }
+    if (duration != nullptr) {
+        *duration = micros() - start;
+    }
+    return found;
 }
 
 
@@ -102,6 +237,46 @@ void PCA9622::setI2CAddress(uint8_t i2c_address) {
     _i2c_address = i2c_address;
 }
 
+/**
+ * @brief Returns the I2C address used by the library
+ * 
+ * @return uint8_t The I2C address
+ */
+uint8_t PCA9622::getI2CAddress() {
+    return _i2c_address;
+}
+
+/**
+ * @brief Sets the I2C bus the device is connected to. Defaults to Wire. @note the bus has to be initialized (begin) by the application
+ * 
+ * @param bus The I2C bus, for example Wire1
+ */
+void PCA9622::setBus(TwoWire *bus) {
+    _wire = bus;
+}
+
+/**
+ * @brief Returns the I2C bus the device is connected to
+ * 
+ * @return TwoWire* The I2C bus
+ */
+TwoWire *PCA9622::getBus() {
+    return _wire;
+}
+
+/**
+ * @brief Records every I2C transaction of all devices to the output in a compact binary trace, with the time and the I2C bus of every transaction. 
+ * The output can be a serial port or a file on an SD card. Replay the trace with extras/trace_replay.py to reconstruct the output state 
+ * and compare the bus cost of two firmware versions. 
+ * @note Recording takes time on every transaction, keep the output fast or buffered
+ * 
+ * @param output The stream to write the trace to. nullptr stops the recording
+ */
+void PCA9622::setTrace(Print *output) {
+    i2c_set_trace(output);
+}
+
+
 /**
  * @brief Sets the sleep bit. Turns off the oscillator and sets the chip to low power mode
  * 
@@ -115,12 +290,12 @@ void PCA9622::sleep() {
  * 
  */
 void PCA9622::wakeUp() {
-    writeRegister(PCA9622_MODE1, (readRegister(PCA9622_MODE1) & ~(PCA9622_Configuration::SLEEP)) | PCA9622_Configuration::WAKEUP);
-    delayMicroseconds(500);
+    startOscillator();
+    delayMicroseconds(PCA9622_WAKEUP_TIME_US);
 }
 
 /**
- * @brief Sets the I2C sub address 1. @note this also sets the class variable
+ * @brief Sets the I2C sub address 1. @note this also sets the class variable, shared by all devices with PCA9622_LOW_FOOTPRINT
  * 
  * @param address The I2C sub address 1 to set
  * @param addressType the I2C address type to write to 
@@ -133,7 +308,7 @@ void PCA9622::setSubAddress1(uint8_t address, EAddressType addressType) {
 }
 
 /**
- * @brief Sets the I2C sub address 2. @note this also sets the class variable
+ * @brief Sets the I2C sub address 2. @note this also sets the class variable, shared by all devices with PCA9622_LOW_FOOTPRINT
  * 
  * @param address The I2C sub address 2 to set
  * @param addressType the I2C address type to write to 
@@ -146,7 +321,7 @@ void PCA9622::setSubAddress2(uint8_t address, EAddressType addressType) {
 }
 
 /**
- * @brief Sets the I2C sub address 3. @note this also sets the class variable
+ * @brief Sets the I2C sub address 3. @note this also sets the class variable, shared by all devices with PCA9622_LOW_FOOTPRINT
  * 
  * @param address The I2C sub address 3 to set
  * @param addressType the I2C address type to write to 
@@ -159,7 +334,7 @@ void PCA9622::setSubAddress3(uint8_t address, EAddressType addressType) {
 }
 
 /**
- * @brief Sets the I2C all call address. @note this also sets the class variable
+ * @brief Sets the I2C all call address. @note this also sets the class variable, shared by all devices with PCA9622_LOW_FOOTPRINT
  * 
  * @param address The I2C all call address to set
  * @param addressType the I2C address type to write to 
@@ -213,7 +388,7 @@ void PCA9622::setLEDOutputState(uint8_t led, LED_State ledState) {
         uint8_t currentState[4];
         readMultiRegister(PCA9622_LED_OUT0 | PCA9622_AI_ALL, currentState, 4);
         
-        uint32_t mask = (uint32_t)0x3F << (led * 6);;
+        uint32_t mask = (uint32_t)0x3F << (led * 6);
         uint32_t state = ((uint32_t)currentState[0] & 0xFF) | (((uint32_t)currentState[1] << 8) & 0xFF00) | (((uint32_t)currentState[2] << 16) & 0xFF0000) | (((uint32_t)currentState[3] << 24) & 0xFF000000);
         state &= ~mask;
         
@@ -232,11 +407,12 @@ void PCA9622::setLEDOutputState(uint8_t led, LED_State ledState) {
 /**
  * @brief Sets the output state of a led channel @note LED channel specified by the device not the library. So it will always change 4 outputs
  * 
- * @param led The led to set the output state of. from 0..3. LED 0 controls output 0..3 and so on
+ * @param led The led to set the output state of. from 0..3 (higher values are clamped to 3). LED 0 controls output 0..3 and so on
  * @param ledState The state of the led to set. See @ref LED_State
  * @param addressType the I2C address type to write to 
  */
 void PCA9622::setOutputState(uint8_t led, LED_State ledState, EAddressType addressType) {
+    if (led > 3) led = 3;
     uint8_t state = ((uint8_t)ledState << 6) | ((uint8_t)ledState << 4) | ((uint8_t)ledState << 2) | ((uint8_t)ledState << 0);
     writeRegister(PCA9622_LED_OUT0 + led, state, addressType);
 }
@@ -260,6 +436,298 @@ void PCA9622::setPWMOutputState(uint8_t output, LED_State ledState, EAddressType
     }
 }
 
+/*----------------------- Power management functions ------------------------*/
+
+#ifndef PCA9622_LOW_FOOTPRINT
+/**
+ * @brief Enables the automatic sleep management. 
+ * When all outputs are dark (PWM value 0 or output state OFF) for longer than the timeout, @ref update puts the device to sleep.
+ * The device is woken up again as soon as a write to the Normal address turns an output on. @note writes through the AllCall or SubCall addresses are not tracked, except the broadcasts of @ref PCA9622Array
+ * 
+ * @param timeout The time in ms that the device has to be idle before it is put to sleep. 0 disables the automatic sleep management
+ */
+void PCA9622::setAutoSleep(uint32_t timeout) {
+    _auto_sleep_timeout = timeout;
+    _idle_since = millis();
+}
+
+/**
+ * @brief Disables the automatic sleep management. The device stays in its current power mode
+ * 
+ */
+void PCA9622::disableAutoSleep() {
+    _auto_sleep_timeout = 0;
+    _activity_pending = false;
+}
+
+/**
+ * @brief Announces that the outputs will be turned on in the given amount of time.
+ * The device will not be put to sleep and if it is asleep @ref update wakes it up early so the oscillator is running when the outputs are turned on
+ * 
+ * @param ms The time in ms until the next transition
+ */
+void PCA9622::scheduleActivity(uint32_t ms) {
+    _activity_pending = true;
+    _activity_at = millis() + ms;
+}
+
+/**
+ * @brief Runs the automatic sleep management. Call this function regularly from the loop, preferably at least once every ms
+ * 
+ */
+void PCA9622::update() {
+    if (_auto_sleep_timeout == 0) return;
+
+    uint32_t now = millis();
+    if (_activity_pending) {
+        if ((int32_t)(now + PCA9622_WAKEUP_TIME_MS - _activity_at) >= 0) {
+            _activity_pending = false;
+            if (_asleep) {
+                startOscillator();
+            }
+        }
+        _idle_since = now;
+        return;
+    }
+
+    if (!isIdle()) {
+        _idle_since = now;
+        return;
+    }
+
+    if (!_asleep && (now - _idle_since) >= _auto_sleep_timeout) {
+        sleep();
+    }
+}
+
+#endif
+
+/**
+ * @brief Returns the tracked power mode of the device. 
+ * In the low footprint mode there is no register shadow and MODE1 is read from the device
+ * 
+ * @return true The device is in low power mode
+ * @return false The oscillator is running
+ */
+bool PCA9622::isAsleep() {
+#ifdef PCA9622_LOW_FOOTPRINT
+    return (readRegister(PCA9622_MODE1) & PCA9622_Configuration::SLEEP) != 0;
+#else
+    return _asleep;
+#endif
+}
+
+/**
+ * @brief Checks if all outputs are dark according to the tracked PWM and LEDOUT registers. 
+ * In the low footprint mode there is no register shadow and the registers are read from the device in a single transaction
+ * 
+ * @return true No output is turned on
+ * @return false At least one output is ON or has a PWM value other than 0, or the registers could not be read
+ */
+bool PCA9622::isIdle() {
+#ifdef PCA9622_LOW_FOOTPRINT
+    uint8_t data[PCA9622_LED_OUT3 - PCA9622_PWM0 + 1];
+    if (readMultiRegister(PCA9622_PWM0 | PCA9622_AI_ALL, data, sizeof(data)) != 0) return false;
+    for (uint8_t i = 0; i < 16; i++) {
+        uint8_t state = (data[PCA9622_LED_OUT0 - PCA9622_PWM0 + (i / 4)] >> ((i % 4) * 2)) & 0x03;
+        if (state == LED_State::ON) return false;
+        if (state != LED_State::OFF && data[i] != 0) return false;
+    }
+#else
+    for (uint8_t i = 0; i < 16; i++) {
+        uint8_t state = (_led_out >> (i * 2)) & 0x03;
+        if (state == LED_State::ON) return false;
+        if (state != LED_State::OFF && (_pwm_active & (1 << i))) return false;
+    }
+#endif
+    return true;
+}
+
+#ifndef PCA9622_LOW_FOOTPRINT
+
+/**
+ * @brief Returns the total time the device has spent in low power mode
+ * 
+ * @return uint32_t The time in ms
+ */
+uint32_t PCA9622::getSleepTime() {
+    if (_asleep) {
+        return _sleep_time + (millis() - _sleep_since);
+    }
+    return _sleep_time;
+}
+
+/**
+ * @brief Returns the amount of times the device has been put to sleep
+ * 
+ * @return uint16_t The amount of sleep periods
+ */
+uint16_t PCA9622::getSleepCount() {
+    return _sleep_count;
+}
+
+
+/*----------------------- Verification functions ----------------------------*/
+
+/**
+ * @brief Compares a register value read from the device with the register shadow. 
+ * The shadow holds the sleep bit of MODE1, whether every PWM output is 0, GRPPWM and the LEDOUT registers. Other registers always match
+ * 
+ * @param regAddress The register address without auto increment flags
+ * @param value The value read from the register
+ * @return true The value matches the shadow or the register is not part of the shadow
+ * @return false The device does not have the expected state, for example after a brownout reset
+ */
+bool PCA9622::matchesShadow(uint8_t regAddress, uint8_t value) {
+    if (regAddress == PCA9622_MODE1) {
+        return ((value & PCA9622_Configuration::SLEEP) != 0) == _asleep;
+    } else if (regAddress >= PCA9622_PWM0 && regAddress < PCA9622_GRPPWM) {
+        return (value != 0) == ((_pwm_active & (1 << (regAddress - PCA9622_PWM0))) != 0);
+    } else if (regAddress == PCA9622_GRPPWM) {
+        return value == _grp_pwm;
+    } else if (regAddress >= PCA9622_LED_OUT0 && regAddress <= PCA9622_LED_OUT3) {
+        return value == (uint8_t)(_led_out >> ((regAddress - PCA9622_LED_OUT0) * 8));
+    }
+    return true;
+}
+
+/**
+ * @brief Writes the register shadow back to the device: the LEDOUT registers in a single transaction, GRPPWM and the sleep bit of MODE1. 
+ * A device that should be asleep is put to sleep again, a device that should be awake gets its oscillator started. 
+ * @note the PWM values, MODE2, GRPFREQ and the I2C addresses are not part of the shadow and have to be restored by the application
+ * 
+ * @return 0:success
+ * @return other:the I2C error, see @ref writeMultiRegister
+ */
+uint8_t PCA9622::restoreShadow() {
+    uint8_t buffer[4];
+    for (uint8_t i = 0; i < 4; i++) {
+        buffer[i] = _led_out >> (i * 8);
+    }
+    uint8_t retVal = writeMultiRegister(PCA9622_LED_OUT0 | PCA9622_AI_ALL, buffer, 4);
+    if (retVal == 0) retVal = writeRegister(PCA9622_GRPPWM, _grp_pwm);
+    if (retVal == 0) {
+        if (_asleep) {
+            sleep();
+        } else {
+            startOscillator();
+        }
+    }
+    return retVal;
+}
+
+/*----------------------- Asynchronous functions ----------------------------*/
+
+/**
+ * @brief Starts @ref begin without blocking. The sequence runs from @ref poll, which does at most one register access per call 
+ * and returns right away while the oscillator starts. Several devices can be initialized at the same time, see @ref PCA9622Array::beginAsync
+ * 
+ * @return true The sequence is started
+ * @return false Another sequence is still running, see @ref isBusy
+ */
+bool PCA9622::beginAsync() {
+    if (isBusy()) return false;
+    if (_OE_pin != 0xFF) {
+        pinMode(_OE_pin, OUTPUT);
+    }
+    disableOutputs();
+    if (_asleep) _sleep_since = millis(); // The time before begin is not counted as sleep time
+    _async_state = EAsyncState::BeginReadMode;
+    return true;
+}
+
+/**
+ * @brief Starts @ref softwareReset without blocking. The sequence runs from @ref poll. 
+ * @warning resets all PCA9622 devices on the I2C Bus of this device!
+ * 
+ * @return true The sequence is started
+ * @return false Another sequence is still running, see @ref isBusy
+ */
+bool PCA9622::softwareResetAsync() {
+    if (isBusy()) return false;
+    _async_state = EAsyncState::Reset;
+    return true;
+}
+
+/**
+ * @brief Starts @ref wakeUp without blocking. The sequence runs from @ref poll and ends when the oscillator is running
+ * 
+ * @return true The sequence is started
+ * @return false Another sequence is still running, see @ref isBusy
+ */
+bool PCA9622::wakeUpAsync() {
+    if (isBusy()) return false;
+    _async_state = EAsyncState::ReadMode;
+    return true;
+}
+
+/**
+ * @brief Runs the next step of the asynchronous sequence. Does at most one register access and never waits. 
+ * Waking up takes two steps: MODE1 is read in one call and written in the next. 
+ * Call this regularly from the loop until it returns false
+ * 
+ * @param now The current time in us. Can be given to run the sequence with a simulated clock
+ * @return true The sequence is still running
+ * @return false No sequence is running
+ */
+bool PCA9622::poll(uint32_t now) {
+    switch (_async_state) {
+        case EAsyncState::BeginReadMode:
+            _async_mode1 = readRegister(PCA9622_MODE1);
+            _async_state = EAsyncState::BeginWakeUp;
+            break;
+        case EAsyncState::BeginWakeUp:
+            startOscillator(_async_mode1);
+            _async_since = now;
+            _async_state = EAsyncState::BeginOutputState;
+            break;
+        case EAsyncState::BeginOutputState:
+            // Register writes are allowed while the oscillator starts
+            writeRepeatRegister(PCA9622_LED_OUT0 | PCA9622_AI_ALL, 0xFF, 4); // Sets the led output state
+            _async_state = EAsyncState::WaitWakeUp;
+            break;
+        case EAsyncState::ReadMode:
+            _async_mode1 = readRegister(PCA9622_MODE1);
+            _async_state = EAsyncState::WakeUp;
+            break;
+        case EAsyncState::WakeUp:
+            startOscillator(_async_mode1);
+            _async_since = now;
+            _async_state = EAsyncState::WaitWakeUp;
+            break;
+        case EAsyncState::WaitWakeUp:
+            if (now - _async_since >= PCA9622_WAKEUP_TIME_US) {
+                _async_state = EAsyncState::Idle;
+            }
+            break;
+        case EAsyncState::Reset:
+            i2c_write_byte(_wire, PCA9622_I2C_SW_RESET, 0xA5, 0x5A);
+            resetShadow();
+            _async_since = now;
+            _async_state = EAsyncState::WaitReset;
+            break;
+        case EAsyncState::WaitReset:
+            if (now - _async_since >= PCA9622_RESET_TIME_US) {
+                _async_state = EAsyncState::Idle;
+            }
+            break;
+        default:
+            break;
+    }
+    return isBusy();
+}
+
+/**
+ * @brief Checks if an asynchronous sequence is running
+ * 
+ * @return true A sequence is running, call @ref poll
+ * @return false No sequence is running
+ */
+bool PCA9622::isBusy() {
+    return _async_state != EAsyncState::Idle;
+}
+#endif
+
 /*----------------------- General control functions -------------------------*/
 
 /**
@@ -269,8 +737,8 @@ void PCA9622::setPWMOutputState(uint8_t output, LED_State ledState, EAddressType
  * @return uint8_t the value from the specified register
  */
 uint8_t PCA9622::readRegister(uint8_t regAddress) {
-    uint8_t data;
-    i2c_read_byte(_i2c_address, regAddress, &data);
+    uint8_t data = 0;
+    i2c_read_byte(_wire, _i2c_address, regAddress, &data);
     return data;
 }
 
@@ -287,7 +755,7 @@ uint8_t PCA9622::readRegister(uint8_t regAddress) {
  * @return 4:other error
  */
 uint8_t PCA9622::writeRegister(uint8_t regAddress, uint8_t data, EAddressType addressType) {
-    return i2c_write_byte(getAddress(addressType), regAddress, data);
+    return writeMultiRegister(regAddress, &data, 1, addressType);
 }
 
 /**
@@ -304,7 +772,55 @@ uint8_t PCA9622::writeRegister(uint8_t regAddress, uint8_t data, EAddressType ad
  * @return 4:other error
  */
 uint8_t PCA9622::writeMultiRegister(uint8_t startAddress, uint8_t *data, uint8_t count, EAddressType addressType) {
-    return i2c_write_multi(getAddress(addressType), startAddress, data, count);
+    uint8_t retVal = i2c_write_multi(_wire, getAddress(addressType), startAddress, data, count);
+#ifndef PCA9622_LOW_FOOTPRINT
+    if (retVal == 0 && addressType == EAddressType::Normal) {
+        onWrite(startAddress, data, count, count);
+    }
+#endif
+    return retVal;
+}
+
+/**
+ * @brief Writes the same value to the specified start address and subsequent addresses without a buffer
+ * 
+ * @param startAddress the register start address to write to
+ * @param value the value to write to the registers
+ * @param count the amount of registers to write
+ * @param addressType the I2C address type to write to 
+ * @return 0:success
+ * @return 1:data too long to fit in transmit buffer
+ * @return 2:received NACK on transmit of address
+ * @return 3:received NACK on transmit of data
+ * @return 4:other error
+ */
+uint8_t PCA9622::writeRepeatRegister(uint8_t startAddress, uint8_t value, uint8_t count, EAddressType addressType) {
+    return writePatternRegister(startAddress, &value, 1, count, addressType);
+}
+
+/**
+ * @brief Writes a repeating pattern to the specified start address and subsequent addresses without a buffer. 
+ * For example a 3 byte RGB value repeated for 15 registers
+ * 
+ * @param startAddress the register start address to write to
+ * @param pattern the pattern to repeat
+ * @param patternLength the length of the pattern
+ * @param count the amount of registers to write
+ * @param addressType the I2C address type to write to 
+ * @return 0:success
+ * @return 1:data too long to fit in transmit buffer
+ * @return 2:received NACK on transmit of address
+ * @return 3:received NACK on transmit of data
+ * @return 4:other error
+ */
+uint8_t PCA9622::writePatternRegister(uint8_t startAddress, const uint8_t *pattern, uint8_t patternLength, uint8_t count, EAddressType addressType) {
+    uint8_t retVal = i2c_write_pattern(_wire, getAddress(addressType), startAddress, pattern, patternLength, count);
+#ifndef PCA9622_LOW_FOOTPRINT
+    if (retVal == 0 && addressType == EAddressType::Normal) {
+        onWrite(startAddress, pattern, patternLength, count);
+    }
+#endif
+    return retVal;
 }
 
 /**
@@ -315,17 +831,20 @@ uint8_t PCA9622::writeMultiRegister(uint8_t startAddress, uint8_t *data, uint8_t
  * @param count the amount of data to read
  */
 uint8_t PCA9622::readMultiRegister(uint8_t startAddress, uint8_t *data, uint8_t count) {
-    return i2c_read_multi(_i2c_address, startAddress, data, count);
+    return i2c_read_multi(_wire, _i2c_address, startAddress, data, count);
 }
 
 /**
- * @brief Drives the ~OE pin low and enables the outputs of the PCA9622
+ * @brief Drives the ~OE pin low and enables the outputs of the PCA9622. 
+ * When an output brightness is set the ~OE pin is driven with PWM again, see @ref setOutputBrightness
  * 
  */
 void PCA9622::enableOutputs() {
-    if (_OE_pin != 0xFF) {
-        digitalWrite(_OE_pin, LOW);
-    }
+#ifdef PCA9622_LOW_FOOTPRINT
+    writeOutputEnable(0xFF);
+#else
+    writeOutputEnable(_oe_duty);
+#endif
 }
 
 /**
@@ -333,19 +852,55 @@ void PCA9622::enableOutputs() {
  * 
  */
 void PCA9622::disableOutputs() {
-    if (_OE_pin != 0xFF) {
-        digitalWrite(_OE_pin, HIGH);
-    }
+    writeOutputEnable(0);
+}
+
+/**
+ * @brief Dims all outputs with PWM on the ~OE pin. This costs no I2C transactions, all devices that share the pin are dimmed at once. 
+ * The ~OE pin must be connected to a PWM capable pin of the microcontroller. 
+ * The brightness multiplies with the PWM value and the group dimming of every output and also dims the outputs that are fully on. 
+ * @note the PWM frequency of the microcontroller (490Hz to 1kHz on most Arduino boards) is not synchronized with the group dimming (190Hz) of the device. 
+ * Combining both at low values can give visible flicker, use GRPPWM at 0xFF or only one of both for fades. 
+ * Set the same brightness on every device that shares the pin to keep @ref getOutputBrightness and the trace in line, see @ref setTrace
+ * 
+ * @param brightness The brightness from 0 (outputs disabled) to 0xFF (outputs always enabled)
+ * @param gamma Applies a gamma correction so steps in brightness look even to the eye. See @ref gammaCorrect
+ */
+#ifndef PCA9622_LOW_FOOTPRINT
+void PCA9622::setOutputBrightness(uint8_t brightness, bool gamma) {
+    _oe_duty = gamma ? gammaCorrect(brightness) : brightness;
+    writeOutputEnable(_oe_duty);
+}
+
+/**
+ * @brief Returns the duty cycle of the outputs on the ~OE pin, after the gamma correction
+ * 
+ * @return uint8_t The duty cycle from 0 to 0xFF
+ */
+uint8_t PCA9622::getOutputBrightness() {
+    return _oe_duty;
+}
+#endif
+
+/**
+ * @brief Corrects a brightness for the eye with a gamma of 2. 0 and 0xFF are kept
+ * 
+ * @param value The brightness from 0 to 0xFF
+ * @return uint8_t The corrected duty cycle
+ */
+uint8_t PCA9622::gammaCorrect(uint8_t value) {
+    return (((uint16_t)value + 1) * ((uint16_t)value + 1) - 1) >> 8;
 }
 
 /**
  * @brief Sets the pwm output of the driver
  * 
- * @param output The output to write to from 0..15
+ * @param output The output to write to from 0..15. Other values are ignored
  * @param value The PWM value to write from 0..255
  * @param addressType the I2C address type to write to 
  */
 void PCA9622::setPWMOutput(uint8_t output, uint8_t value, EAddressType addressType) {
+    if (output > 15) return;
     writeRegister(PCA9622_PWM0 + output, value, addressType);
 }
 
@@ -356,11 +911,7 @@ void PCA9622::setPWMOutput(uint8_t output, uint8_t value, EAddressType addressTy
  * @param addressType the I2C address type to write to 
  */
 void PCA9622::setAllPWMOutputs(uint8_t value, EAddressType addressType) {
-    uint8_t buffer[16];
-    for (uint8_t i = 0; i < 16; i++) {
-        buffer[i] = value;
-    }
-    writeMultiRegister(PCA9622_PWM0 | PCA9622_AI_INDIVIDUAL, buffer, 16, addressType);
+    writeRepeatRegister(PCA9622_PWM0 | PCA9622_AI_INDIVIDUAL, value, 16, addressType);
 }
 
 /**
@@ -385,13 +936,32 @@ void PCA9622::setGroupPWM(uint8_t value, EAddressType addressType) {
  * @return uint16_t The real time in ms that the register will be programmed to as not all values are valid
  */
 uint16_t PCA9622::setGroupFrequency(uint16_t ms, EAddressType addressType) {
+    uint8_t regValue = groupFrequencyRegister(ms);
+    writeRegister(PCA9622_GRPFREQ, regValue, addressType);
+    return groupFrequencyPeriod(regValue);
+}
+
+/**
+ * @brief Calculates the GRPFREQ register value for a blinking delay
+ * 
+ * @param ms the blinking delay in ms from 42..10666. Values outside this range are clamped
+ * @return uint8_t The GRPFREQ value with the closest blinking delay
+ */
+uint8_t PCA9622::groupFrequencyRegister(uint16_t ms) {
     if (ms < 42) ms = 42;
     if (ms > 10666) ms = 10666;
-    uint8_t regValue = (uint8_t)((((uint32_t)ms * 24) - 1000) / 1000);
-    uint16_t actualValue = (uint16_t)(((regValue + 1) * 1000) / 24);
+    // The blinking period is (GRPFREQ + 1) / 24 s, round to the closest register value
+    return (uint8_t)(((((uint32_t)ms * 24) + 500) / 1000) - 1);
+}
 
-    writeRegister(PCA9622_GRPFREQ, regValue, addressType);
-    return actualValue;
+/**
+ * @brief Calculates the blinking delay of a GRPFREQ register value
+ * 
+ * @param regValue the GRPFREQ value
+ * @return uint16_t The blinking delay in ms
+ */
+uint16_t PCA9622::groupFrequencyPeriod(uint8_t regValue) {
+    return (uint16_t)(((((uint32_t)regValue + 1) * 1000) + 12) / 24);
 }
 
 
@@ -399,23 +969,26 @@ uint16_t PCA9622::setGroupFrequency(uint16_t ms, EAddressType addressType) {
 
 /**
  * @brief Sets the LED color according to the set LED configuration @ref setLEDConfiguration
+ * @note with an RGBA like configuration the 3 outputs are turned off, use the variant with an amber value
  * 
- * @param led The LED to set the color of. If the led configuration is set to RGB or alike (3 color channels) a maximum of 5 leds are supported
+ * @param led The LED to set the color of. If the led configuration is set to RGB or alike (3 color channels) a maximum of 5 leds are supported (0..4, higher values are clamped to 4)
  * @param red The red color value from 0 to 0xFF
  * @param green The green color value from 0 to 0xFF
  * @param blue The blue color value from 0 to 0xFF
  * @param addressType the I2C address type to write to
  */
 void PCA9622::setLEDColor(uint8_t led, uint8_t red, uint8_t green, uint8_t blue, EAddressType addressType) {
-    uint8_t buffer[3];
+    if (led > 4) led = 4;
+    uint8_t buffer[3] = {0};
     fillLEDbuffer(red, green, blue, buffer);
     writeMultiRegister((PCA9622_PWM0 + (3 * led)) | PCA9622_AI_INDIVIDUAL, buffer, 3, addressType);
 }
 
 /**
- * @brief 
+ * @brief Sets the LED color according to the set LED configuration @ref setLEDConfiguration
+ * @note with an RGB like configuration the 4 outputs are turned off, use the variant without an amber value
  * 
- * @param led The LED to set the color of. If the led configuration is set to RGBA or alike (4 color channels) a maximum of 4 leds are supported
+ * @param led The LED to set the color of. If the led configuration is set to RGBA or alike (4 color channels) a maximum of 4 leds are supported (0..3, higher values are clamped to 3)
  * @param red The red color value from 0 to 0xFF
  * @param green The green color value from 0 to 0xFF
  * @param blue The blue color value from 0 to 0xFF
@@ -423,7 +996,8 @@ void PCA9622::setLEDColor(uint8_t led, uint8_t red, uint8_t green, uint8_t blue,
  * @param addressType the I2C address type to write to
  */
 void PCA9622::setLEDColor(uint8_t led, uint8_t red, uint8_t green, uint8_t blue, uint8_t amber, EAddressType addressType) {
-    uint8_t buffer[4];
+    if (led > 3) led = 3;
+    uint8_t buffer[4] = {0};
     fillLEDbuffer(red, green, blue, amber, buffer);
     writeMultiRegister((PCA9622_PWM0 + (4 * led)) | PCA9622_AI_INDIVIDUAL, buffer, 4, addressType);
 }
@@ -437,9 +1011,9 @@ void PCA9622::setLEDColor(uint8_t led, uint8_t red, uint8_t green, uint8_t blue,
  * @param addressType the I2C address type to write to
  */
 void PCA9622::setAllLEDColor(uint8_t red, uint8_t green, uint8_t blue, EAddressType addressType) {
-    uint8_t buffer[3*5];
-    fillLEDbuffer(red, green, blue, buffer, 5);
-    writeMultiRegister(PCA9622_PWM0 | PCA9622_AI_INDIVIDUAL, buffer, 15, addressType);
+    uint8_t buffer[3] = {0};
+    fillLEDbuffer(red, green, blue, buffer);
+    writePatternRegister(PCA9622_PWM0 | PCA9622_AI_INDIVIDUAL, buffer, 3, 15, addressType);
 }
 
 /**
@@ -452,9 +1026,204 @@ void PCA9622::setAllLEDColor(uint8_t red, uint8_t green, uint8_t blue, EAddressT
  * @param addressType the I2C address type to write to
  */
 void PCA9622::setAllLEDColor(uint8_t red, uint8_t green, uint8_t blue, uint8_t amber, EAddressType addressType) {
-    uint8_t buffer[4*4];
-    fillLEDbuffer(red, green, blue, amber, buffer, 4);
-    writeMultiRegister(PCA9622_PWM0 | PCA9622_AI_INDIVIDUAL, buffer, 16, addressType);
+    uint8_t buffer[4] = {0};
+    fillLEDbuffer(red, green, blue, amber, buffer);
+    writePatternRegister(PCA9622_PWM0 | PCA9622_AI_INDIVIDUAL, buffer, 4, 16, addressType);
+}
+
+
+/*----------------------- Color space functions -----------------------------*/
+
+/**
+ * @brief Sets the LED color from a HSV color according to the set LED configuration @ref setLEDConfiguration. 
+ * On RGBA like configurations the amber channel is turned off
+ * 
+ * @param led The LED to set the color of
+ * @param hue The hue from 0 to 0xFF for the full color wheel. 0 is red, 85 is green and 170 is blue
+ * @param saturation The saturation from 0 to 0xFF
+ * @param value The value (brightness) from 0 to 0xFF
+ * @param addressType the I2C address type to write to
+ */
+void PCA9622::setLEDColorHSV(uint8_t led, uint8_t hue, uint8_t saturation, uint8_t value, EAddressType addressType) {
+    uint8_t rgb[3];
+    hsvToRGB(hue, saturation, value, rgb);
+    writeLEDColors(led, rgb, 1, false, addressType);
+}
+
+/**
+ * @brief Sets the LED color from a HSL color according to the set LED configuration @ref setLEDConfiguration. 
+ * On RGBA like configurations the amber channel is turned off
+ * 
+ * @param led The LED to set the color of
+ * @param hue The hue from 0 to 0xFF for the full color wheel. 0 is red, 85 is green and 170 is blue
+ * @param saturation The saturation from 0 to 0xFF
+ * @param lightness The lightness from 0 to 0xFF. 0x80 gives the fully saturated color
+ * @param addressType the I2C address type to write to
+ */
+void PCA9622::setLEDColorHSL(uint8_t led, uint8_t hue, uint8_t saturation, uint8_t lightness, EAddressType addressType) {
+    uint8_t rgb[3];
+    hslToRGB(hue, saturation, lightness, rgb);
+    writeLEDColors(led, rgb, 1, false, addressType);
+}
+
+/**
+ * @brief Sets the LED color to a white color temperature according to the set LED configuration @ref setLEDConfiguration. 
+ * On RGBA like configurations the common part of the red, green and blue channels is moved to the fourth (white) channel
+ * 
+ * @param led The LED to set the color of
+ * @param kelvin The color temperature from @ref PCA9622_KELVIN_MIN to @ref PCA9622_KELVIN_MAX
+ * @param brightness The brightness from 0 to 0xFF
+ * @param addressType the I2C address type to write to
+ */
+void PCA9622::setLEDColorTemperature(uint8_t led, uint16_t kelvin, uint8_t brightness, EAddressType addressType) {
+    uint8_t rgb[3];
+    kelvinToRGB(kelvin, brightness, rgb);
+    writeLEDColors(led, rgb, 1, true, addressType);
+}
+
+/**
+ * @brief Sets the color of consecutive LEDs from HSV colors in a single transaction. See @ref setLEDColorHSV
+ * 
+ * @param startLed The first LED to set the color of
+ * @param hsv The colors as hue, saturation, value triplets
+ * @param count The amount of LEDs. Limited to the LEDs available from startLed
+ * @param addressType the I2C address type to write to
+ */
+void PCA9622::setLEDColorsHSV(uint8_t startLed, const uint8_t *hsv, uint8_t count, EAddressType addressType) {
+    uint8_t rgb[3*5];
+    if (count > 5) count = 5;
+    hsvToRGB(hsv, rgb, count);
+    writeLEDColors(startLed, rgb, count, false, addressType);
+}
+
+/**
+ * @brief Sets the color of consecutive LEDs from HSL colors in a single transaction. See @ref setLEDColorHSL
+ * 
+ * @param startLed The first LED to set the color of
+ * @param hsl The colors as hue, saturation, lightness triplets
+ * @param count The amount of LEDs. Limited to the LEDs available from startLed
+ * @param addressType the I2C address type to write to
+ */
+void PCA9622::setLEDColorsHSL(uint8_t startLed, const uint8_t *hsl, uint8_t count, EAddressType addressType) {
+    uint8_t rgb[3*5];
+    if (count > 5) count = 5;
+    hslToRGB(hsl, rgb, count);
+    writeLEDColors(startLed, rgb, count, false, addressType);
+}
+
+/**
+ * @brief Sets the color temperature of consecutive LEDs in a single transaction. See @ref setLEDColorTemperature
+ * 
+ * @param startLed The first LED to set the color of
+ * @param kelvin The color temperatures
+ * @param brightness The brightness from 0 to 0xFF
+ * @param count The amount of LEDs. Limited to the LEDs available from startLed
+ * @param addressType the I2C address type to write to
+ */
+void PCA9622::setLEDColorsTemperature(uint8_t startLed, const uint16_t *kelvin, uint8_t brightness, uint8_t count, EAddressType addressType) {
+    uint8_t rgb[3*5];
+    if (count > 5) count = 5;
+    kelvinToRGB(kelvin, brightness, rgb, count);
+    writeLEDColors(startLed, rgb, count, true, addressType);
+}
+
+/**
+ * @brief Converts a HSV color to RGB using 8-bit fixed point math
+ * 
+ * @param hue The hue from 0 to 0xFF for the full color wheel
+ * @param saturation The saturation from 0 to 0xFF
+ * @param value The value from 0 to 0xFF
+ * @param rgb The buffer for the red, green and blue values (3 bytes)
+ */
+void PCA9622::hsvToRGB(uint8_t hue, uint8_t saturation, uint8_t value, uint8_t *rgb) {
+    uint8_t chroma = ((uint16_t)value * (saturation + 1)) >> 8;
+    hueToRGB(hue, chroma, value - chroma, rgb);
+}
+
+/**
+ * @brief Converts a HSL color to RGB using 8-bit fixed point math
+ * 
+ * @param hue The hue from 0 to 0xFF for the full color wheel
+ * @param saturation The saturation from 0 to 0xFF
+ * @param lightness The lightness from 0 to 0xFF
+ * @param rgb The buffer for the red, green and blue values (3 bytes)
+ */
+void PCA9622::hslToRGB(uint8_t hue, uint8_t saturation, uint8_t lightness, uint8_t *rgb) {
+    // Chroma is largest at half lightness: (1 - |2L - 1|) * S. The distance to black or white of 0..127 is stretched to 0..255
+    uint8_t distance = (lightness < 128) ? lightness : (255 - lightness);
+    uint8_t range = (distance << 1) + (distance >> 6);
+    uint8_t chroma = ((uint16_t)range * (saturation + 1)) >> 8;
+    // The dark half rounds towards its minimum and the light half towards its maximum, so a saturated color at half lightness is pure
+    uint8_t offset = (lightness < 128) ? lightness - (chroma >> 1) : lightness + (chroma >> 1) - chroma;
+    hueToRGB(hue, chroma, offset, rgb);
+}
+
+/**
+ * @brief Converts a color temperature to RGB. Interpolates between the entries of a black body lookup table
+ * 
+ * @param kelvin The color temperature from @ref PCA9622_KELVIN_MIN to @ref PCA9622_KELVIN_MAX. Values outside this range are clamped
+ * @param brightness The brightness from 0 to 0xFF
+ * @param rgb The buffer for the red, green and blue values (3 bytes)
+ */
+void PCA9622::kelvinToRGB(uint16_t kelvin, uint8_t brightness, uint8_t *rgb) {
+    if (kelvin < PCA9622_KELVIN_MIN) kelvin = PCA9622_KELVIN_MIN;
+    if (kelvin > PCA9622_KELVIN_MAX) kelvin = PCA9622_KELVIN_MAX;
+    uint16_t offset = kelvin - PCA9622_KELVIN_MIN;
+    const uint8_t *entry = &kelvinTable[(offset >> 9) * 3];
+    uint8_t fraction = (offset & 0x1FF) >> 1;
+
+    for (uint8_t i = 0; i < 3; i++) {
+        uint8_t low = pgm_read_byte(entry + i);
+        uint8_t high = pgm_read_byte(entry + i + 3);
+        uint8_t color = low + (((int16_t)(high - low) * fraction) >> 8);
+        rgb[i] = ((uint16_t)color * (brightness + 1)) >> 8;
+    }
+}
+
+/**
+ * @brief Converts an array of HSV colors to RGB. See @ref hsvToRGB
+ * 
+ * @param hsv The colors as hue, saturation, value triplets
+ * @param rgb The buffer for the red, green and blue values (3 bytes per color)
+ * @param count The amount of colors to convert
+ */
+void PCA9622::hsvToRGB(const uint8_t *hsv, uint8_t *rgb, uint16_t count) {
+    while (count--) {
+        hsvToRGB(hsv[0], hsv[1], hsv[2], rgb);
+        hsv += 3;
+        rgb += 3;
+    }
+}
+
+/**
+ * @brief Converts an array of HSL colors to RGB. See @ref hslToRGB
+ * 
+ * @param hsl The colors as hue, saturation, lightness triplets
+ * @param rgb The buffer for the red, green and blue values (3 bytes per color)
+ * @param count The amount of colors to convert
+ */
+void PCA9622::hslToRGB(const uint8_t *hsl, uint8_t *rgb, uint16_t count) {
+    while (count--) {
+        hslToRGB(hsl[0], hsl[1], hsl[2], rgb);
+        hsl += 3;
+        rgb += 3;
+    }
+}
+
+/**
+ * @brief Converts an array of color temperatures to RGB. See @ref kelvinToRGB
+ * 
+ * @param kelvin The color temperatures
+ * @param brightness The brightness from 0 to 0xFF
+ * @param rgb The buffer for the red, green and blue values (3 bytes per color)
+ * @param count The amount of colors to convert
+ */
+void PCA9622::kelvinToRGB(const uint16_t *kelvin, uint8_t brightness, uint8_t *rgb, uint16_t count) {
+    while (count--) {
+        kelvinToRGB(kelvin[0], brightness, rgb);
+        kelvin++;
+        rgb += 3;
+    }
 }
 
 
@@ -494,6 +1263,216 @@ uint8_t PCA9622::getAddress(EAddressType addressType) {
     return i2c_address;
 }
 
+/**
+ * @brief Checks if the address is one of the power up AllCall or SubCall addresses, these are skipped while scanning
+ * 
+ * @param i2c_address The I2C address to check
+ * @return true The address is reserved
+ * @return false The address can be used as a device address
+ */
+bool PCA9622::isReservedAddress(uint8_t i2c_address) {
+    return i2c_address == PCA9622_I2C_ALL_CALL || i2c_address == PCA9622_I2C_SUB_1 || i2c_address == PCA9622_I2C_SUB_2 || i2c_address == PCA9622_I2C_SUB_3;
+}
+
+#ifndef PCA9622_LOW_FOOTPRINT
+/**
+ * @brief Handles a successful write to the Normal address. Updates the register shadow and wakes the device when the automatic sleep management is enabled
+ * 
+ * @param startAddress the register start address including the auto increment flags
+ * @param pattern the data written to the registers, repeated until count bytes are written
+ * @param patternLength the length of the pattern
+ * @param count the amount of data written
+ */
+void PCA9622::onWrite(uint8_t startAddress, const uint8_t *pattern, uint8_t patternLength, uint8_t count) {
+    bool wasIdle = isIdle();
+    trackWrite(startAddress, pattern, patternLength, count);
+    if (_auto_sleep_timeout != 0 && _asleep && wasIdle && !isIdle()) {
+        startOscillator();
+    }
+}
+
+/**
+ * @brief Updates the register shadow with the data written to the device. Follows the auto increment roll over of the device
+ * 
+ * @param startAddress the register start address including the auto increment flags
+ * @param pattern the data written to the registers, repeated until count bytes are written
+ * @param patternLength the length of the pattern
+ * @param count the amount of data written
+ */
+void PCA9622::trackWrite(uint8_t startAddress, const uint8_t *pattern, uint8_t patternLength, uint8_t count) {
+    uint8_t reg = startAddress & 0x1F;
+    uint8_t autoIncrement = startAddress & 0xE0;
+    uint8_t index = 0;
+    while (count--) {
+        uint8_t data = pattern[index];
+        if (reg == PCA9622_MODE1) {
+            trackSleep(data & PCA9622_Configuration::SLEEP);
+        } else if (reg >= PCA9622_PWM0 && reg < PCA9622_GRPPWM) {
+            if (data != 0) {
+                _pwm_active |= (1 << (reg - PCA9622_PWM0));
+            } else {
+                _pwm_active &= ~(1 << (reg - PCA9622_PWM0));
+            }
+        } else if (reg == PCA9622_GRPPWM) {
+            _grp_pwm = data;
+        } else if (reg >= PCA9622_LED_OUT0 && reg <= PCA9622_LED_OUT3) {
+            uint8_t shift = (reg - PCA9622_LED_OUT0) * 8;
+            _led_out = (_led_out & ~((uint32_t)0xFF << shift)) | ((uint32_t)data << shift);
+        }
+        if (++index >= patternLength) index = 0;
+
+        switch (autoIncrement) {
+            case PCA9622_AI_ALL:
+                reg = (reg >= PCA9622_ALL_CALL) ? PCA9622_MODE1 : reg + 1;
+                break;
+            case PCA9622_AI_INDIVIDUAL:
+                reg = (reg >= PCA9622_PWM0 + 15) ? PCA9622_PWM0 : reg + 1;
+                break;
+            case PCA9622_AI_GLOBAL:
+                reg = (reg >= PCA9622_GRPFREQ) ? PCA9622_GRPPWM : reg + 1;
+                break;
+            case PCA9622_AI_INDI_GLOBAL:
+                reg = (reg >= PCA9622_GRPFREQ) ? PCA9622_PWM0 : reg + 1;
+                break;
+            default: // No auto increment
+                break;
+        }
+    }
+}
+
+/**
+ * @brief Keeps track of the power mode and the time spent in low power mode
+ * 
+ * @param asleep The new power mode of the device
+ */
+void PCA9622::trackSleep(bool asleep) {
+    if (asleep == _asleep) return;
+    if (asleep) {
+        _sleep_since = millis();
+        _sleep_count++;
+    } else {
+        _sleep_time += millis() - _sleep_since;
+        _idle_since = millis();
+    }
+    _asleep = asleep;
+}
+
+/**
+ * @brief Resets the register shadow to the power up values of the device
+ * 
+ */
+void PCA9622::resetShadow() {
+    trackSleep(true);
+    _pwm_active = 0;
+    _led_out = 0;
+    _grp_pwm = 0xFF;
+}
+#endif
+
+/**
+ * @brief Drives the ~OE pin. Fully enabled and disabled outputs use a digital level which also stops the PWM of the pin
+ * 
+ * @param duty The duty cycle of the outputs, the pin is active low
+ */
+void PCA9622::writeOutputEnable(uint8_t duty) {
+    if (_OE_pin == 0xFF) return;
+    if (duty == 0xFF) {
+        digitalWrite(_OE_pin, LOW);
+    } else if (duty == 0) {
+        digitalWrite(_OE_pin, HIGH);
+    } else {
+        analogWrite(_OE_pin, 0xFF - duty);
+    }
+    i2c_trace_output_enable(_wire, _i2c_address, duty);
+}
+
+/**
+ * @brief Clears the sleep bit without waiting for the oscillator to start. Register writes are allowed right away, the outputs follow within 500us
+ * 
+ */
+void PCA9622::startOscillator() {
+    startOscillator(readRegister(PCA9622_MODE1));
+}
+
+/**
+ * @brief Clears the sleep bit in a MODE1 value read before and writes it. Lets the asynchronous sequences read and write MODE1 in separate steps
+ * 
+ * @param mode1 The value of MODE1 read from the device
+ */
+void PCA9622::startOscillator(uint8_t mode1) {
+    writeRegister(PCA9622_MODE1, (mode1 & ~(PCA9622_Configuration::SLEEP)) | PCA9622_Configuration::WAKEUP);
+}
+
+/**
+ * @brief Returns the amount of LEDs of the set LED configuration @ref setLEDConfiguration
+ * 
+ * @return uint8_t 5 for RGB like configurations and 4 for RGBA like configurations
+ */
+uint8_t PCA9622::getLEDCount() {
+    return (_led_configuration < 6) ? 5 : 4;
+}
+
+/**
+ * @brief Writes the colors of consecutive LEDs in a single transaction according to the set LED configuration @ref setLEDConfiguration
+ * 
+ * @param startLed The first LED to write
+ * @param rgb The red, green and blue values of the LEDs (3 bytes per LED)
+ * @param count The amount of LEDs. Limited to the LEDs available from startLed
+ * @param extractWhite On RGBA like configurations move the common part of red, green and blue to the fourth channel. Otherwise the fourth channel is turned off
+ * @param addressType the I2C address type to write to
+ */
+void PCA9622::writeLEDColors(uint8_t startLed, uint8_t *rgb, uint8_t count, bool extractWhite, EAddressType addressType) {
+    uint8_t ledCount = getLEDCount();
+    if (startLed >= ledCount) return;
+    if (count > ledCount - startLed) count = ledCount - startLed;
+
+    uint8_t buffer[16];
+    uint8_t channels = (ledCount == 5) ? 3 : 4;
+    for (uint8_t i = 0; i < count; i++) {
+        uint8_t *color = &rgb[i * 3];
+        if (channels == 3) {
+            fillLEDbuffer(color[0], color[1], color[2], &buffer[i * 3]);
+        } else {
+            uint8_t white = 0;
+            if (extractWhite) {
+                white = color[0];
+                if (color[1] < white) white = color[1];
+                if (color[2] < white) white = color[2];
+            }
+            fillLEDbuffer(color[0] - white, color[1] - white, color[2] - white, white, &buffer[i * 4]);
+        }
+    }
+    writeMultiRegister((PCA9622_PWM0 + (channels * startLed)) | PCA9622_AI_INDIVIDUAL, buffer, channels * count, addressType);
+}
+
+/**
+ * @brief Converts a hue with a given chroma and offset to RGB. Shared by the HSV and HSL conversions
+ * 
+ * @param hue The hue from 0 to 0xFF for the full color wheel
+ * @param chroma The difference between the largest and smallest channel
+ * @param offset The value of the smallest channel
+ * @param rgb The buffer for the red, green and blue values (3 bytes)
+ */
+void PCA9622::hueToRGB(uint8_t hue, uint8_t chroma, uint8_t offset, uint8_t *rgb) {
+    uint16_t scaledHue = (uint16_t)hue * 6;
+    uint8_t fraction = scaledHue & 0xFF;
+    uint8_t rising = ((uint16_t)chroma * fraction) >> 8;
+    uint8_t falling = chroma - rising;
+
+    uint8_t red, green, blue;
+    switch (scaledHue >> 8) {
+        case 0:  red = chroma;  green = rising;  blue = 0;       break;
+        case 1:  red = falling; green = chroma;  blue = 0;       break;
+        case 2:  red = 0;       green = chroma;  blue = rising;  break;
+        case 3:  red = 0;       green = falling; blue = chroma;  break;
+        case 4:  red = rising;  green = 0;       blue = chroma;  break;
+        default: red = chroma;  green = 0;       blue = falling; break;
+    }
+    rgb[0] = red + offset;
+    rgb[1] = green + offset;
+    rgb[2] = blue + offset;
+}
+
 /**
  * @brief Fills a led buffer acording to the set LED configuration @ref setLEDConfiguration
  * 
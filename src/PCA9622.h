@@ -15,6 +15,11 @@
 #include <Arduino.h>
 #include <Wire.h>
 
+// Uncomment or define as build flag to reduce the RAM usage per device. Do not define it in a sketch, the library has to be compiled with the same setting
+// Shares the AllCall and SubCall addresses between all devices and leaves out the register shadow, the automatic sleep management, the verification, 
+// the output brightness and the asynchronous functions. See the README for the memory usage
+// #define PCA9622_LOW_FOOTPRINT
+
 #define PCA9622_I2C_ALL_CALL    0xE0
 #define PCA9622_I2C_SW_RESET    0x06
 #define PCA9622_I2C_SUB_1       0xE2
@@ -44,6 +49,19 @@
 #define PCA9622_AI_GLOBAL       0xC0 // Auto increment global control registers only. roll over at 0x13 to 0x12 
 #define PCA9622_AI_INDI_GLOBAL  0xE0 // Auto increment individual and global registers only. roll over at 0x13 to 0x02
 
+// Discovery
+#define PCA9622_I2C_FIRST_ADDRESS 0x10 // First non reserved address (7-bit 0x08)
+#define PCA9622_I2C_LAST_ADDRESS  0xEE // Last non reserved address (7-bit 0x77)
+
+// Color temperature
+#define PCA9622_KELVIN_MIN      1000  // Lowest supported color temperature
+#define PCA9622_KELVIN_MAX      12000 // Highest supported color temperature
+
+// Timing
+#define PCA9622_WAKEUP_TIME_MS  1    // Oscillator start up time (500us) rounded up to the millis() resolution
+#define PCA9622_WAKEUP_TIME_US  500  // Oscillator start up time
+#define PCA9622_RESET_TIME_US   20   // Time for a software reset to complete, longer than the bus free time at every bus speed
+
 enum LED_Configuration {
     RGB,
     GRB,
@@ -100,6 +118,7 @@ enum PCA9622_Configuration {
 class PCA9622
 {
 public:
+    PCA9622(); // Constructor without address, used for device arrays filled by scan
     PCA9622(uint8_t i2c_address); // Constructor
     PCA9622(uint8_t i2c_address, uint8_t outputEnablePin); // Constructor with ~OE pin
     PCA9622(uint8_t i2c_address, uint8_t outputEnablePin, LED_Configuration ledConfiguration); // Constructor with specific led configuration
@@ -113,6 +132,17 @@ public:
     void setOutputEnablePin(uint8_t outputEnablePin);
     void setLEDConfiguration(LED_Configuration ledConfiguration);
     void setI2CAddress(uint8_t i2c_address);
+    uint8_t getI2CAddress();
+    void setBus(TwoWire *bus);
+    TwoWire *getBus();
+    static void setTrace(Print *output);
+
+    /**
+     * Discovery functions
+     */
+    static bool probe(uint8_t i2c_address, TwoWire *bus = &Wire);
+    static uint8_t scan(uint8_t *addresses, uint8_t maxCount, uint32_t *duration = nullptr, TwoWire *bus = &Wire);
+    static uint8_t scan(PCA9622 *devices, uint8_t maxCount, uint32_t *duration = nullptr, TwoWire *bus = &Wire);
 
     /**
      * Configuration functions
@@ -130,6 +160,37 @@ public:
     void setOutputState(uint8_t led, LED_State ledState, EAddressType addressType = EAddressType::Normal);
     void setPWMOutputState(uint8_t output, LED_State ledState, EAddressType addressType = EAddressType::Normal);
 
+    /**
+     * Power management functions
+     */
+    bool isAsleep();
+    bool isIdle();
+#ifndef PCA9622_LOW_FOOTPRINT
+    void setAutoSleep(uint32_t timeout);
+    void disableAutoSleep();
+    void scheduleActivity(uint32_t ms);
+    void update();
+    uint32_t getSleepTime();
+    uint16_t getSleepCount();
+#endif
+
+#ifndef PCA9622_LOW_FOOTPRINT
+    /**
+     * Verification functions
+     */
+    bool matchesShadow(uint8_t regAddress, uint8_t value);
+    uint8_t restoreShadow();
+
+    /**
+     * Asynchronous functions
+     */
+    bool beginAsync();
+    bool softwareResetAsync();
+    bool wakeUpAsync();
+    bool poll(uint32_t now = micros());
+    bool isBusy();
+#endif
+
     /**
      * General control functions
      */
@@ -137,16 +198,25 @@ public:
     uint8_t writeRegister(uint8_t regAddress, uint8_t data, EAddressType addressType = EAddressType::Normal);
 
     uint8_t writeMultiRegister(uint8_t startAddress, uint8_t *data, uint8_t count, EAddressType addressType = EAddressType::Normal);
+    uint8_t writeRepeatRegister(uint8_t startAddress, uint8_t value, uint8_t count, EAddressType addressType = EAddressType::Normal);
+    uint8_t writePatternRegister(uint8_t startAddress, const uint8_t *pattern, uint8_t patternLength, uint8_t count, EAddressType addressType = EAddressType::Normal);
     uint8_t readMultiRegister(uint8_t startAddress, uint8_t *data, uint8_t count);
 
     void enableOutputs();
     void disableOutputs();
+#ifndef PCA9622_LOW_FOOTPRINT
+    void setOutputBrightness(uint8_t brightness, bool gamma = false);
+    uint8_t getOutputBrightness();
+#endif
+    static uint8_t gammaCorrect(uint8_t value);
 
     void setPWMOutput(uint8_t output, uint8_t value, EAddressType addressType = EAddressType::Normal);
     void setAllPWMOutputs(uint8_t value, EAddressType addressType = EAddressType::Normal);
 
     void setGroupPWM(uint8_t value, EAddressType addressType = EAddressType::Normal);
     uint16_t setGroupFrequency(uint16_t ms, EAddressType addressType = EAddressType::Normal);
+    static uint8_t groupFrequencyRegister(uint16_t ms);
+    static uint16_t groupFrequencyPeriod(uint8_t regValue);
 
     /**
      * RGB control functions
@@ -157,20 +227,83 @@ public:
     void setAllLEDColor(uint8_t red, uint8_t green, uint8_t blue, EAddressType addressType = EAddressType::Normal);
     void setAllLEDColor(uint8_t red, uint8_t green, uint8_t blue, uint8_t amber, EAddressType addressType = EAddressType::Normal);
 
+    /**
+     * Color space functions
+     */
+    void setLEDColorHSV(uint8_t led, uint8_t hue, uint8_t saturation, uint8_t value, EAddressType addressType = EAddressType::Normal);
+    void setLEDColorHSL(uint8_t led, uint8_t hue, uint8_t saturation, uint8_t lightness, EAddressType addressType = EAddressType::Normal);
+    void setLEDColorTemperature(uint8_t led, uint16_t kelvin, uint8_t brightness, EAddressType addressType = EAddressType::Normal);
+    void setLEDColorsHSV(uint8_t startLed, const uint8_t *hsv, uint8_t count, EAddressType addressType = EAddressType::Normal);
+    void setLEDColorsHSL(uint8_t startLed, const uint8_t *hsl, uint8_t count, EAddressType addressType = EAddressType::Normal);
+    void setLEDColorsTemperature(uint8_t startLed, const uint16_t *kelvin, uint8_t brightness, uint8_t count, EAddressType addressType = EAddressType::Normal);
+
+    static void hsvToRGB(uint8_t hue, uint8_t saturation, uint8_t value, uint8_t *rgb);
+    static void hslToRGB(uint8_t hue, uint8_t saturation, uint8_t lightness, uint8_t *rgb);
+    static void kelvinToRGB(uint16_t kelvin, uint8_t brightness, uint8_t *rgb);
+    static void hsvToRGB(const uint8_t *hsv, uint8_t *rgb, uint16_t count);
+    static void hslToRGB(const uint8_t *hsl, uint8_t *rgb, uint16_t count);
+    static void kelvinToRGB(const uint16_t *kelvin, uint8_t brightness, uint8_t *rgb, uint16_t count);
+
 protected:
 private:
+    friend class PCA9622Effects; // Uses the LED configuration to render pixels
+    friend class PCA9622Array; // Tracks broadcast writes in the register shadow and counts the outputs that are fully on
+
     uint8_t _OE_pin = 0xFF;
+    TwoWire *_wire = &Wire;
 
-    uint8_t _i2c_address;
+    uint8_t _i2c_address = 0;
+#ifdef PCA9622_LOW_FOOTPRINT
+    // Shared by all devices
+    static uint8_t _i2c_address_all_call;
+    static uint8_t _i2c_address_sub_1;
+    static uint8_t _i2c_address_sub_2;
+    static uint8_t _i2c_address_sub_3;
+#else
     uint8_t _i2c_address_all_call = PCA9622_I2C_ALL_CALL;
-    uint8_t _i2c_address_sw_reset = PCA9622_I2C_SW_RESET;
     uint8_t _i2c_address_sub_1 = PCA9622_I2C_SUB_1;
     uint8_t _i2c_address_sub_2 = PCA9622_I2C_SUB_2;
     uint8_t _i2c_address_sub_3 = PCA9622_I2C_SUB_3;
+#endif
 
     LED_Configuration _led_configuration = RGB;
 
+#ifndef PCA9622_LOW_FOOTPRINT
+    uint8_t _oe_duty = 0xFF; // Duty cycle of the outputs on the ~OE pin, 0xFF: always enabled
+
+    // Register shadow used by the power management and the verification. Only writes to the Normal address are tracked
+    bool _asleep = true; // The PCA9622 powers up and resets in low power mode
+    uint16_t _pwm_active = 0; // One bit per output with a PWM value other than 0
+    uint32_t _led_out = 0; // LEDOUT0..3 registers
+    uint8_t _grp_pwm = 0xFF; // GRPPWM register
+
+    uint32_t _auto_sleep_timeout = 0; // 0: auto sleep disabled
+    uint32_t _idle_since = 0;
+    bool _activity_pending = false;
+    uint32_t _activity_at = 0;
+    uint32_t _sleep_since = 0;
+    uint32_t _sleep_time = 0;
+    uint16_t _sleep_count = 0;
+
+    uint8_t _async_state = 0; // Step of the running asynchronous sequence, 0: idle
+    uint32_t _async_since = 0; // Start of the current wait in us
+    uint8_t _async_mode1 = 0; // MODE1 read in the step before the wake up
+#endif
+
     uint8_t getAddress(EAddressType addressType);
+    static bool isReservedAddress(uint8_t i2c_address);
+#ifndef PCA9622_LOW_FOOTPRINT
+    void onWrite(uint8_t startAddress, const uint8_t *pattern, uint8_t patternLength, uint8_t count);
+    void trackWrite(uint8_t startAddress, const uint8_t *pattern, uint8_t patternLength, uint8_t count);
+    void trackSleep(bool asleep);
+    void resetShadow();
+#endif
+    void writeOutputEnable(uint8_t duty);
+    void startOscillator();
+    void startOscillator(uint8_t mode1);
+    uint8_t getLEDCount();
+    void writeLEDColors(uint8_t startLed, uint8_t *rgb, uint8_t count, bool extractWhite, EAddressType addressType);
+    static void hueToRGB(uint8_t hue, uint8_t chroma, uint8_t offset, uint8_t *rgb);
     void fillLEDbuffer(uint8_t red, uint8_t green, uint8_t blue, uint8_t *buffer, uint8_t ledCount = 1);
     void fillLEDbuffer(uint8_t red, uint8_t green, uint8_t blue, uint8_t amber, uint8_t *buffer, uint8_t ledCount = 1);
 };
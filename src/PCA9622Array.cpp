@@ -0,0 +1,782 @@
+/**
+ * @file PCA9622Array.cpp
+ * @author rneurink (ruben.neurink@gmail.com)
+ * @brief Framebuffer for a fixture of multiple PCA9622 devices
+ * @version 1.1.0
+ * @date 2026-10-18
+ * 
+ * @copyright Copyright (c) 2021
+ * 
+ */
+#include "PCA9622Array.h"
+
+/*----------------------- Initialisation functions --------------------------*/
+
+/**
+ * @brief This function instantiates the class object
+ * 
+ * @param devices The PCA9622 devices of the fixture
+ * @param deviceCount The amount of devices. Limited to @ref PCA9622_ARRAY_MAX_DEVICES. 
+ * The devices may use up to @ref PCA9622_ARRAY_MAX_BUSES different buses, the first device on another bus and all devices after it are left out. 
+ * @ref begin returns false when devices were left out, check @ref getDeviceCount for the amount of devices in the array
+ * @param framebuffer The framebuffer of deviceCount * @ref PCA9622_OUTPUT_COUNT bytes. Holds the PWM values of all outputs, its content is written on the first @ref flush
+ */
+PCA9622Array::PCA9622Array(PCA9622 *devices, uint8_t deviceCount, uint8_t *framebuffer) {
+    _devices = devices;
+    _device_count = (deviceCount > PCA9622_ARRAY_MAX_DEVICES) ? PCA9622_ARRAY_MAX_DEVICES : deviceCount;
+    _framebuffer = framebuffer;
+    for (uint8_t d = 0; d < _device_count; d++) {
+        int8_t bus = addBus(_devices[d].getBus());
+        if (bus < 0) {
+            // No room for another bus, leave this and the following devices out
+            _device_count = d;
+            break;
+        }
+        _device_bus[d] = bus;
+    }
+    _left_out = deviceCount - _device_count;
+    invalidate();
+}
+
+/**
+ * @brief Initializes all devices. The content of the framebuffer is written on the next @ref flush
+ * 
+ * @return true All devices given to the constructor are in the array
+ * @return false Devices were left out by the constructor because they exceed @ref PCA9622_ARRAY_MAX_DEVICES or use a bus that does not fit. 
+ * The devices in the array are initialized anyway, see @ref getDeviceCount
+ */
+bool PCA9622Array::begin() {
+    for (uint8_t d = 0; d < _device_count; d++) {
+        _devices[d].begin();
+    }
+    invalidate();
+    return _left_out == 0;
+}
+
+#ifndef PCA9622_LOW_FOOTPRINT
+/**
+ * @brief Starts the initialization of all devices without blocking. 
+ * The devices are initialized interleaved from @ref poll, so the oscillators of all devices start at the same time instead of one after the other. 
+ * The content of the framebuffer is written on the next @ref flush after the initialization
+ * 
+ * @return true The sequence is started on all devices
+ * @return false A device is still running another sequence, see @ref isBusy. No device is started
+ */
+bool PCA9622Array::beginAsync() {
+    if (isBusy()) return false;
+    bool started = true;
+    for (uint8_t d = 0; d < _device_count; d++) {
+        if (!_devices[d].beginAsync()) started = false;
+    }
+    invalidate();
+    return started;
+}
+
+/**
+ * @brief Starts waking up all devices without blocking, see @ref PCA9622::wakeUpAsync and @ref poll
+ * 
+ * @return true The sequence is started on all devices
+ * @return false A device is still running another sequence, see @ref isBusy. No device is started
+ */
+bool PCA9622Array::wakeUpAsync() {
+    if (isBusy()) return false;
+    bool started = true;
+    for (uint8_t d = 0; d < _device_count; d++) {
+        if (!_devices[d].wakeUpAsync()) started = false;
+    }
+    return started;
+}
+
+/**
+ * @brief Runs the next step of the asynchronous sequence of every busy device. 
+ * Does at most one register access per device and never waits. Call this regularly from the loop until it returns false
+ * 
+ * @param now The current time in us. Can be given to run the sequences with a simulated clock
+ * @return true At least one device is still busy
+ * @return false All devices are done
+ */
+bool PCA9622Array::poll(uint32_t now) {
+    bool busy = false;
+    for (uint8_t d = 0; d < _device_count; d++) {
+        if (_devices[d].poll(now)) busy = true;
+    }
+    return busy;
+}
+
+/**
+ * @brief Checks if a device is running an asynchronous sequence
+ * 
+ * @return true At least one device is busy, call @ref poll
+ * @return false All devices are done
+ */
+bool PCA9622Array::isBusy() {
+    for (uint8_t d = 0; d < _device_count; d++) {
+        if (_devices[d].isBusy()) return true;
+    }
+    return false;
+}
+#endif
+
+/**
+ * @brief Returns the amount of devices in the array
+ * 
+ * @return uint8_t The amount of devices. Less than the deviceCount given to the constructor when the devices did not fit, see @ref PCA9622Array
+ */
+uint8_t PCA9622Array::getDeviceCount() {
+    return _device_count;
+}
+
+/**
+ * @brief Returns a device of the array for direct access
+ * 
+ * @param device The index of the device
+ * @return PCA9622& The device
+ */
+PCA9622 &PCA9622Array::getDevice(uint8_t device) {
+    return _devices[device];
+}
+
+
+/*----------------------- Framebuffer functions -----------------------------*/
+
+/**
+ * @brief Sets the PWM value of an output in the framebuffer
+ * 
+ * @param device The index of the device
+ * @param output The output from 0..15
+ * @param value The PWM value from 0..255
+ */
+void PCA9622Array::setPWM(uint8_t device, uint8_t output, uint8_t value) {
+    if (device >= _device_count || output >= PCA9622_OUTPUT_COUNT) return;
+    uint8_t *pwm = &_framebuffer[(device * PCA9622_OUTPUT_COUNT) + output];
+    if (*pwm == value) return;
+    _pwm_sum = _pwm_sum - *pwm + value;
+    *pwm = value;
+    _dirty[device] |= (1 << output);
+}
+
+/**
+ * @brief Returns the PWM value of an output in the framebuffer
+ * 
+ * @param device The index of the device
+ * @param output The output from 0..15
+ * @return uint8_t The PWM value. 0 if the device or output does not exist
+ */
+uint8_t PCA9622Array::getPWM(uint8_t device, uint8_t output) {
+    if (device >= _device_count || output >= PCA9622_OUTPUT_COUNT) return 0;
+    return _framebuffer[(device * PCA9622_OUTPUT_COUNT) + output];
+}
+
+/**
+ * @brief Sets all outputs of all devices in the framebuffer to the same PWM value
+ * 
+ * @param value The PWM value from 0..255
+ */
+void PCA9622Array::fill(uint8_t value) {
+    for (uint8_t d = 0; d < _device_count; d++) {
+        for (uint8_t i = 0; i < PCA9622_OUTPUT_COUNT; i++) {
+            setPWM(d, i, value);
+        }
+    }
+}
+
+/**
+ * @brief Sets all outputs of all devices to the same value and writes them directly with a single transaction per bus through a broadcast address. 
+ * The value is streamed to the bus without a buffer. When a current budget is set the value is scaled down, see @ref setCurrentBudget. 
+ * Devices of the array that are asleep are woken up first when the value turns the outputs on, and the register shadow of every device on a written bus is updated, 
+ * so the automatic sleep management sees the outputs that are on, see @ref PCA9622::setAutoSleep. In the low footprint mode this reads MODE1 of every device. 
+ * @note every device on the bus that responds to the broadcast address is written, also devices that are not part of the array
+ * 
+ * @param value The pwm duty cycle
+ * @param addressType the broadcast address the devices respond to. The AllCall address is enabled by default on every device
+ * @return 0:success
+ * @return other:the error of the first failed transaction, see @ref PCA9622::writeRepeatRegister. Failed buses are written on the next flush
+ */
+uint8_t PCA9622Array::fillBroadcast(uint8_t value, EAddressType addressType) {
+    fill(value);
+    prepareFlush();
+    uint8_t scaled = (_applied_scale == PCA9622_SCALE_NONE) ? value : (uint8_t)(((uint16_t)value * _applied_scale) >> 8);
+
+    if (scaled != 0) {
+        for (uint8_t d = 0; d < _device_count; d++) {
+            if (_devices[d].isAsleep()) _devices[d].startOscillator();
+        }
+    }
+
+    uint8_t retVal = 0;
+    for (uint8_t b = 0; b < _bus_count; b++) {
+        int8_t d = getBusDevice(b);
+        if (d < 0) continue;
+        uint32_t start = micros();
+        uint8_t result = _devices[d].writeRepeatRegister(PCA9622_PWM0 | PCA9622_AI_INDIVIDUAL, scaled, PCA9622_OUTPUT_COUNT, addressType);
+        _bus_frame_time[b] = micros() - start;
+        _bus_frame_bytes[b] = PCA9622_OUTPUT_COUNT + 2; // Address, control register and data
+        if (result == 0) {
+#ifndef PCA9622_LOW_FOOTPRINT
+            trackBusWrite(b, PCA9622_PWM0 | PCA9622_AI_INDIVIDUAL, scaled, PCA9622_OUTPUT_COUNT);
+#endif
+            for (uint8_t i = 0; i < _device_count; i++) {
+                if (_device_bus[i] == b) _dirty[i] = 0;
+            }
+        } else if (retVal == 0) {
+            retVal = result;
+        }
+    }
+    return retVal;
+}
+
+/**
+ * @brief Writes the changed outputs of the framebuffer to the devices on all buses. 
+ * Every changed device costs a single transaction from its first to its last changed output. 
+ * When a current budget is set the PWM values are scaled down to stay within the budget, see @ref setCurrentBudget
+ * 
+ * @return 0:success
+ * @return other:the error of the first failed transaction, see @ref PCA9622::writeMultiRegister. Failed devices are retried on the next flush
+ */
+uint8_t PCA9622Array::flush() {
+    prepareFlush();
+    uint8_t retVal = 0;
+    for (uint8_t b = 0; b < _bus_count; b++) {
+        uint8_t result = flushBus(b);
+        if (retVal == 0) retVal = result;
+    }
+    return retVal;
+}
+
+/**
+ * @brief Updates the current scale for the next frame. When the scale changes all outputs are marked to be written. 
+ * Call this once per frame before calling @ref flushBus for every bus, @ref flush does this automatically
+ * 
+ */
+void PCA9622Array::prepareFlush() {
+    uint16_t scale = getCurrentScale();
+    if (scale != _applied_scale) {
+        _applied_scale = scale;
+        for (uint8_t d = 0; d < _device_count; d++) {
+            _dirty[d] = 0xFFFF;
+        }
+    }
+}
+
+/**
+ * @brief Writes the changed outputs of the devices on a single bus. 
+ * Different buses can be flushed at the same time, for example from a task per bus on multi core platforms. See @ref prepareFlush
+ * 
+ * @param bus The index of the bus, see @ref getBus
+ * @return 0:success
+ * @return other:the error of the first failed transaction, see @ref PCA9622::writeMultiRegister. Failed devices are retried on the next flush
+ */
+uint8_t PCA9622Array::flushBus(uint8_t bus) {
+    if (bus >= _bus_count) return 0;
+    uint32_t start = micros();
+    uint16_t bytes = 0;
+
+    uint8_t retVal = 0;
+    for (uint8_t d = 0; d < _device_count; d++) {
+        if (_device_bus[d] != bus || _dirty[d] == 0) continue;
+        uint8_t result = flushDevice(d, &bytes);
+        if (retVal == 0) retVal = result;
+    }
+
+    _bus_frame_time[bus] = micros() - start;
+    _bus_frame_bytes[bus] = bytes;
+    return retVal;
+}
+
+/**
+ * @brief Marks all outputs to be written on the next flush and recalculates the sum of the framebuffer used by the current estimation. 
+ * Call this after writing to the framebuffer directly instead of through @ref setPWM
+ * 
+ */
+void PCA9622Array::invalidate() {
+    _pwm_sum = 0;
+    for (uint8_t d = 0; d < _device_count; d++) {
+        _dirty[d] = 0xFFFF;
+        for (uint8_t i = 0; i < PCA9622_OUTPUT_COUNT; i++) {
+            _pwm_sum += _framebuffer[(d * PCA9622_OUTPUT_COUNT) + i];
+        }
+    }
+}
+
+/**
+ * @brief Sets the group duty cycle of all devices. See @ref PCA9622::setGroupPWM. The value is used in the current estimation
+ * 
+ * @param value The pwm duty cycle
+ */
+void PCA9622Array::setGroupPWM(uint8_t value) {
+    _group_pwm = value;
+    for (uint8_t d = 0; d < _device_count; d++) {
+        _devices[d].setGroupPWM(value);
+    }
+}
+
+
+/*----------------------- Group blinking functions --------------------------*/
+
+/**
+ * @brief Enables group blinking with the same delay and duty cycle on all devices and restarts the blinking of all devices at the same moment. 
+ * Every bus costs one transaction for MODE2 and one for GRPPWM and GRPFREQ through a broadcast address, followed by @ref resyncGroupBlinking
+ * 
+ * @param ms the blinking delay in ms from 42..10666. See @ref PCA9622::setGroupFrequency
+ * @param dutyCycle the ON/OFF ratio of the blinking pattern. See @ref PCA9622::setGroupPWM
+ * @param addressType the broadcast address the devices respond to. The AllCall address is enabled by default on every device
+ * @return uint16_t The real blinking delay in ms as not all values are valid
+ */
+uint16_t PCA9622Array::setGroupBlinking(uint16_t ms, uint8_t dutyCycle, EAddressType addressType) {
+    uint8_t buffer[2] = {dutyCycle, PCA9622::groupFrequencyRegister(ms)};
+    for (uint8_t b = 0; b < _bus_count; b++) {
+        int8_t d = getBusDevice(b);
+        if (d < 0) continue;
+        _devices[d].enableGroupBlinking(addressType);
+        if (_devices[d].writeMultiRegister(PCA9622_GRPPWM | PCA9622_AI_GLOBAL, buffer, 2, addressType) == 0) {
+#ifndef PCA9622_LOW_FOOTPRINT
+            trackBusWrite(b, PCA9622_GRPPWM, dutyCycle, 1);
+#endif
+        }
+    }
+    _group_pwm = dutyCycle;
+    resyncGroupBlinking(addressType);
+    return PCA9622::groupFrequencyPeriod(buffer[1]);
+}
+
+/**
+ * @brief Restarts the blinking of all devices at the same moment. 
+ * The oscillators of all devices are stopped and started again with a sleep and wake up through a broadcast address. 
+ * With multiple buses the devices on the next bus restart one transaction later. 
+ * Returns without waiting, the blinking starts again once the oscillators run after @ref PCA9622_WAKEUP_TIME_US. The registers can be written in the meantime. 
+ * @note all devices are awake afterwards and the MODE1 register of the first device on every bus is used for all devices on that bus
+ * 
+ * @param addressType the broadcast address the devices respond to. The AllCall address is enabled by default on every device
+ */
+void PCA9622Array::resyncGroupBlinking(EAddressType addressType) {
+    uint8_t mode1[PCA9622_ARRAY_MAX_BUSES];
+    for (uint8_t b = 0; b < _bus_count; b++) {
+        int8_t d = getBusDevice(b);
+        if (d < 0) continue;
+        mode1[b] = _devices[d].readRegister(PCA9622_MODE1) & 0x1F;
+    }
+    for (uint8_t b = 0; b < _bus_count; b++) {
+        int8_t d = getBusDevice(b);
+        if (d < 0) continue;
+        uint8_t value = mode1[b] | PCA9622_Configuration::SLEEP;
+        if (_devices[d].writeRegister(PCA9622_MODE1, value, addressType) == 0) {
+#ifndef PCA9622_LOW_FOOTPRINT
+            trackBusWrite(b, PCA9622_MODE1, value, 1);
+#endif
+        }
+    }
+    for (uint8_t b = 0; b < _bus_count; b++) {
+        int8_t d = getBusDevice(b);
+        if (d < 0) continue;
+        uint8_t value = mode1[b] & ~(PCA9622_Configuration::SLEEP);
+        if (_devices[d].writeRegister(PCA9622_MODE1, value, addressType) == 0) {
+#ifndef PCA9622_LOW_FOOTPRINT
+            trackBusWrite(b, PCA9622_MODE1, value, 1);
+#endif
+        }
+    }
+    _last_resync = millis();
+    _resync_address_type = addressType;
+}
+
+/**
+ * @brief Restarts the blinking periodically from @ref update to correct the drift between the oscillators of the devices
+ * 
+ * @param ms The time between two restarts in ms. 0 disables the periodic restart
+ */
+void PCA9622Array::setBlinkResyncInterval(uint32_t ms) {
+    _resync_interval = ms;
+    _last_resync = millis();
+}
+
+/**
+ * @brief Runs the periodic tasks of the array. Call this function regularly from the loop
+ * 
+ */
+void PCA9622Array::update() {
+    if (_resync_interval != 0 && (millis() - _last_resync) >= _resync_interval) {
+        resyncGroupBlinking(_resync_address_type);
+    }
+#ifndef PCA9622_LOW_FOOTPRINT
+    if (_verify_budget != 0 && _device_count != 0 && (int32_t)(micros() - _verify_next) >= 0) {
+        uint32_t start = micros();
+        uint8_t bus = _device_bus[(_verify_device < _device_count) ? _verify_device : 0];
+        uint16_t bytes = 0;
+        verifyStep(&bytes);
+        // The bus time of the step from the time per byte of the last flush of the bus, the step time until a frame is flushed
+        uint32_t busTime = micros() - start;
+        if (_bus_frame_bytes[bus] != 0) busTime = ((uint32_t)bytes * _bus_frame_time[bus]) / _bus_frame_bytes[bus];
+        // Wait long enough that the verification stays within its share of the bus time
+        _verify_next = start + (busTime * 100) / _verify_budget;
+    }
+#endif
+}
+
+
+/*----------------------- Bus functions -------------------------------------*/
+
+/**
+ * @brief Moves a device to another I2C bus. 
+ * Splitting the devices over multiple buses lowers the frame time of every bus, see @ref flushBus. @note @ref flush writes the buses one after the other, so the total frame time does not go down
+ * 
+ * @param device The index of the device
+ * @param bus The I2C bus, for example Wire1. @note the bus has to be initialized (begin) by the application
+ * @return true The device is moved
+ * @return false The device does not exist or the maximum of @ref PCA9622_ARRAY_MAX_BUSES buses is reached
+ */
+bool PCA9622Array::setDeviceBus(uint8_t device, TwoWire *bus) {
+    if (device >= _device_count) return false;
+    int8_t index = addBus(bus);
+    if (index < 0) return false;
+    _devices[device].setBus(bus);
+    _device_bus[device] = index;
+    _dirty[device] = 0xFFFF;
+    return true;
+}
+
+/**
+ * @brief Returns the bus index of a device
+ * 
+ * @param device The index of the device
+ * @return uint8_t The index of the bus, see @ref getBus
+ */
+uint8_t PCA9622Array::getDeviceBus(uint8_t device) {
+    if (device >= _device_count) return 0;
+    return _device_bus[device];
+}
+
+/**
+ * @brief Returns the amount of I2C buses used by the array
+ * 
+ * @return uint8_t The amount of buses
+ */
+uint8_t PCA9622Array::getBusCount() {
+    return _bus_count;
+}
+
+/**
+ * @brief Returns an I2C bus used by the array
+ * 
+ * @param bus The index of the bus
+ * @return TwoWire* The I2C bus. nullptr if the bus does not exist
+ */
+TwoWire *PCA9622Array::getBus(uint8_t bus) {
+    if (bus >= _bus_count) return nullptr;
+    return _buses[bus];
+}
+
+/**
+ * @brief Returns the duration of the last flush of a bus
+ * 
+ * @param bus The index of the bus
+ * @return uint32_t The frame time in us
+ */
+uint32_t PCA9622Array::getBusFrameTime(uint8_t bus) {
+    if (bus >= _bus_count) return 0;
+    return _bus_frame_time[bus];
+}
+
+/**
+ * @brief Returns the amount of bytes written on a bus in the last flush, including the address and control bytes
+ * 
+ * @param bus The index of the bus
+ * @return uint16_t The amount of bytes
+ */
+uint16_t PCA9622Array::getBusFrameBytes(uint8_t bus) {
+    if (bus >= _bus_count) return 0;
+    return _bus_frame_bytes[bus];
+}
+
+
+/*----------------------- Current budget functions --------------------------*/
+
+/**
+ * @brief Sets the current of a single output at a PWM value of 255. This is the current set by the REXT resistor of the devices
+ * 
+ * @param mA The output current in mA. 0 disables the current budget
+ */
+void PCA9622Array::setChannelCurrent(uint8_t mA) {
+    _channel_current = mA;
+}
+
+/**
+ * @brief Sets the maximum current of the fixture. 
+ * When the estimated current of the framebuffer exceeds the budget, all PWM values are scaled down proportionally on @ref flush. 
+ * Outputs in LEDOUT ON draw the full channel current and can not be scaled, the other outputs share the rest of the budget. 
+ * The framebuffer itself keeps the unscaled values. @note the estimation assumes the other outputs are in PWM_AND_GROUP_CONTROL with group dimming, as set by @ref PCA9622::begin. 
+ * In the low footprint mode there is no register shadow and outputs in LEDOUT ON are not counted
+ * 
+ * @param mA The current budget in mA. 0 disables the current budget
+ */
+void PCA9622Array::setCurrentBudget(uint32_t mA) {
+    _current_budget = mA;
+}
+
+/**
+ * @brief Estimates the current of the fixture from the unscaled framebuffer, the channel current and the group duty cycle. 
+ * Outputs in LEDOUT ON according to the register shadow of the devices count as fully on. 
+ * The sum of the framebuffer is kept up to date by @ref setPWM, so only the outputs that are fully on are visited
+ * 
+ * @return uint32_t The estimated current in mA
+ */
+uint32_t PCA9622Array::getEstimatedCurrent() {
+    uint32_t fullOn;
+    return estimateCurrent(&fullOn);
+}
+
+/**
+ * @brief Returns the scale factor the PWM values are multiplied with on @ref flush to stay within the current budget
+ * 
+ * @return uint16_t The scale factor in 8.8 fixed point. @ref PCA9622_SCALE_NONE when the budget is not exceeded or disabled, 0 when the outputs that are fully on exceed the budget by themselves
+ */
+uint16_t PCA9622Array::getCurrentScale() {
+    if (_current_budget == 0 || _channel_current == 0) return PCA9622_SCALE_NONE;
+    uint32_t fullOn;
+    uint32_t estimate = estimateCurrent(&fullOn);
+    if (estimate <= _current_budget) return PCA9622_SCALE_NONE;
+    // The outputs that are fully on can not be scaled down, the other outputs share the rest of the budget
+    if (fullOn >= _current_budget) return 0;
+    return (uint16_t)(((_current_budget - fullOn) << 8) / (estimate - fullOn));
+}
+
+
+#ifndef PCA9622_LOW_FOOTPRINT
+/*----------------------- Verification functions ----------------------------*/
+
+/**
+ * @brief Verifies the devices in the background from @ref update, for example to recover from a brownout that reset a device. 
+ * Every step reads a window of registers of one device in a single transaction, the windows rotate over MODE1 on its own and PWM0..LEDOUT3. See @ref verifyNext
+ * 
+ * @param budgetPercent The maximum share of the bus time used by the verification from 1..100. 0 disables the background verification. 
+ * The bus time of a step is its bytes times the time per byte of the last flush of the bus, see @ref getBusFrameTime
+ * @param windowSize The amount of registers verified per step from 1..22
+ */
+void PCA9622Array::setVerification(uint8_t budgetPercent, uint8_t windowSize) {
+    if (budgetPercent > 100) budgetPercent = 100;
+    if (windowSize == 0) windowSize = 1;
+    if (windowSize > PCA9622_LED_OUT3 - PCA9622_PWM0 + 1) windowSize = PCA9622_LED_OUT3 - PCA9622_PWM0 + 1;
+    _verify_budget = budgetPercent;
+    _verify_window_size = windowSize;
+    _verify_device = 0;
+    _verify_register = PCA9622_MODE1;
+    _verify_next = micros();
+}
+
+/**
+ * @brief Verifies the next window of the next device and repairs the registers that differ from the expected state. 
+ * The PWM values are compared with the framebuffer (outputs that are not flushed yet are skipped) 
+ * and MODE1, GRPPWM and LEDOUT with the register shadow of the device, see @ref PCA9622::matchesShadow. 
+ * Differing PWM values are written again from the first to the last differing output in a single transaction. 
+ * When the sleep state differs the device has lost its state and the shadow and all PWM values are restored. 
+ * @note MODE2, GRPFREQ and the I2C addresses are not restored
+ * 
+ * @return 0:success
+ * @return other:the error of the first failed transaction, see @ref PCA9622::readMultiRegister and @ref PCA9622::writeMultiRegister
+ */
+uint8_t PCA9622Array::verifyNext() {
+    uint16_t bytes = 0;
+    return verifyStep(&bytes);
+}
+
+/**
+ * @brief Returns the amount of repairs done by the verification
+ * 
+ * @return uint16_t The amount of repairs
+ */
+uint16_t PCA9622Array::getRepairCount() {
+    return _repair_count;
+}
+#endif
+
+
+/*------------------------- Helper functions --------------------------------*/
+
+/**
+ * @brief Writes the changed outputs of a device from its first to its last changed output in a single transaction
+ * 
+ * @param device The index of the device
+ * @param bytes Incremented with the bytes written on the bus
+ * @return 0:success
+ * @return other:the error of the transaction, see @ref PCA9622::writeMultiRegister. The outputs stay marked as changed
+ */
+uint8_t PCA9622Array::flushDevice(uint8_t device, uint16_t *bytes) {
+    uint16_t dirty = _dirty[device];
+    if (dirty == 0) return 0;
+
+    uint8_t first = 0;
+    while (!(dirty & (1 << first))) first++;
+    uint8_t last = PCA9622_OUTPUT_COUNT - 1;
+    while (!(dirty & (1 << last))) last--;
+
+    // Without scaling the framebuffer is written directly, otherwise the scaled values are staged in the buffer
+    uint8_t buffer[PCA9622_OUTPUT_COUNT];
+    uint8_t *data = &_framebuffer[device * PCA9622_OUTPUT_COUNT + first];
+    if (_applied_scale != PCA9622_SCALE_NONE) {
+        for (uint8_t i = 0; i <= last - first; i++) {
+            buffer[i] = (uint8_t)(((uint16_t)data[i] * _applied_scale) >> 8);
+        }
+        data = buffer;
+    }
+
+    uint8_t result = _devices[device].writeMultiRegister((PCA9622_PWM0 + first) | PCA9622_AI_INDIVIDUAL, data, last - first + 1);
+    *bytes += last - first + 3; // Address, control register and data
+    if (result == 0) {
+        _dirty[device] = 0;
+    }
+    return result;
+}
+
+/*
+ *  PRIVATE
+ */ 
+
+/**
+ * @brief Estimates the current of the fixture, see @ref getEstimatedCurrent
+ * 
+ * @param fullOn Set to the part of the current drawn by the outputs in LEDOUT ON
+ * @return uint32_t The estimated current in mA
+ */
+uint32_t PCA9622Array::estimateCurrent(uint32_t *fullOn) {
+    uint32_t pwmSum = _pwm_sum;
+    uint16_t onCount = 0;
+#ifndef PCA9622_LOW_FOOTPRINT
+    for (uint8_t d = 0; d < _device_count; d++) {
+        uint32_t ledOut = _devices[d]._led_out;
+        uint32_t on = ledOut & ~(ledOut >> 1) & 0x55555555; // LEDOUT 01 per output
+        for (uint8_t i = 0; on != 0; i++, on >>= 2) {
+            if (on & 0x01) {
+                onCount++;
+                pwmSum -= _framebuffer[(d * PCA9622_OUTPUT_COUNT) + i];
+            }
+        }
+    }
+#endif
+    *fullOn = (uint32_t)onCount * _channel_current;
+    return *fullOn + (((((uint32_t)pwmSum * _channel_current) >> 8) * ((uint16_t)_group_pwm + 1)) >> 8);
+}
+
+/**
+ * @brief Returns the index of a bus and adds it to the array when it is not used yet
+ * 
+ * @param bus The I2C bus
+ * @return int8_t The index of the bus. -1 if the maximum of @ref PCA9622_ARRAY_MAX_BUSES buses is reached
+ */
+int8_t PCA9622Array::addBus(TwoWire *bus) {
+    for (uint8_t b = 0; b < _bus_count; b++) {
+        if (_buses[b] == bus) return b;
+    }
+    if (_bus_count >= PCA9622_ARRAY_MAX_BUSES) return -1;
+    _buses[_bus_count] = bus;
+    _bus_frame_time[_bus_count] = 0;
+    _bus_frame_bytes[_bus_count] = 0;
+    return _bus_count++;
+}
+
+/**
+ * @brief Returns the first device on a bus. Broadcasts on a bus are sent through this device
+ * 
+ * @param bus The index of the bus
+ * @return int8_t The index of the device. -1 if no device is on the bus
+ */
+int8_t PCA9622Array::getBusDevice(uint8_t bus) {
+    for (uint8_t d = 0; d < _device_count; d++) {
+        if (_device_bus[d] == bus) return d;
+    }
+    return -1;
+}
+
+#ifndef PCA9622_LOW_FOOTPRINT
+/**
+ * @brief Updates the register shadow of all devices on a bus after a broadcast write. 
+ * Broadcasts are not tracked by the devices themselves, without this the verification would repair the devices again 
+ * and the automatic sleep management would not see the outputs that are turned on
+ * 
+ * @param bus The index of the bus
+ * @param startAddress the register start address including the auto increment flags
+ * @param value the value written to the registers
+ * @param count the amount of registers written
+ */
+void PCA9622Array::trackBusWrite(uint8_t bus, uint8_t startAddress, uint8_t value, uint8_t count) {
+    for (uint8_t d = 0; d < _device_count; d++) {
+        if (_device_bus[d] == bus) _devices[d].trackWrite(startAddress, &value, 1, count);
+    }
+}
+
+/**
+ * @brief Runs a verification step, see @ref verifyNext
+ * 
+ * @param bytes Incremented with the bytes transferred on the bus
+ * @return 0:success
+ * @return other:the error of the first failed transaction
+ */
+uint8_t PCA9622Array::verifyStep(uint16_t *bytes) {
+    if (_device_count == 0) return 0;
+    if (_verify_device >= _device_count) _verify_device = 0;
+    uint8_t d = _verify_device;
+    uint8_t first = _verify_register;
+    uint8_t last = (first == PCA9622_MODE1) ? PCA9622_MODE1 : first + _verify_window_size - 1;
+    if (last > PCA9622_LED_OUT3) last = PCA9622_LED_OUT3;
+
+    // Every device is verified with the same window before the window moves on
+    if (++_verify_device >= _device_count) {
+        _verify_device = 0;
+        if (first == PCA9622_MODE1) {
+            _verify_register = PCA9622_PWM0;
+        } else {
+            _verify_register = (last >= PCA9622_LED_OUT3) ? PCA9622_MODE1 : last + 1;
+        }
+    }
+
+    PCA9622 &device = _devices[d];
+    uint8_t data[PCA9622_LED_OUT3 - PCA9622_PWM0 + 1];
+    uint8_t retVal = device.readMultiRegister(first | PCA9622_AI_ALL, data, last - first + 1);
+    *bytes += last - first + 4; // Address, control register, address and data
+    if (retVal != 0) return retVal;
+
+    if (first == PCA9622_MODE1) {
+        if (device.matchesShadow(PCA9622_MODE1, data[0])) return 0;
+        _repair_count++;
+        retVal = device.restoreShadow();
+        *bytes += 16; // LEDOUT, GRPPWM and the read and write of MODE1
+        _dirty[d] = 0xFFFF;
+        uint8_t result = flushDevice(d, bytes);
+        return (retVal == 0) ? result : retVal;
+    }
+
+    bool restore = false;
+    uint16_t differs = 0;
+    uint8_t *pwm = &_framebuffer[d * PCA9622_OUTPUT_COUNT];
+    for (uint8_t reg = first; reg <= last; reg++) {
+        uint8_t value = data[reg - first];
+        if (reg < PCA9622_GRPPWM) {
+            uint8_t output = reg - PCA9622_PWM0;
+            if (_dirty[d] & (1 << output)) continue;
+            uint8_t expected = (_applied_scale == PCA9622_SCALE_NONE) ? pwm[output] : (uint8_t)(((uint16_t)pwm[output] * _applied_scale) >> 8);
+            if (value != expected) differs |= (1 << output);
+        } else if (reg == PCA9622_GRPPWM) {
+            if (!device.matchesShadow(reg, value)) {
+                _repair_count++;
+                uint8_t result = device.writeRegister(PCA9622_GRPPWM, device._grp_pwm);
+                *bytes += 3;
+                if (retVal == 0) retVal = result;
+            }
+        } else if (!device.matchesShadow(reg, value)) {
+            restore = true;
+        }
+    }
+
+    if (restore) {
+        _repair_count++;
+        uint8_t result = device.restoreShadow();
+        *bytes += 16;
+        if (retVal == 0) retVal = result;
+    }
+    if (differs != 0) {
+        _repair_count++;
+        _dirty[d] |= differs;
+        uint8_t result = flushDevice(d, bytes);
+        if (retVal == 0) retVal = result;
+    }
+    return retVal;
+}
+#endif
@@ -0,0 +1,153 @@
+/**
+ * @file PCA9622Array.h
+ * @author rneurink (ruben.neurink@gmail.com)
+ * @brief Framebuffer for a fixture of multiple PCA9622 devices
+ * @version 1.1.0
+ * @date 2026-10-18
+ * 
+ * @copyright Copyright (c) 2021
+ * 
+ */
+
+#ifndef __PCA9622_ARRAY_H
+#define __PCA9622_ARRAY_H
+
+#include <Arduino.h>
+#include "PCA9622.h"
+
+// The maximum amount of devices and I2C buses in an array. Can be overridden with a build flag
+#ifdef PCA9622_LOW_FOOTPRINT
+#ifndef PCA9622_ARRAY_MAX_DEVICES
+#define PCA9622_ARRAY_MAX_DEVICES 8
+#endif
+#ifndef PCA9622_ARRAY_MAX_BUSES
+#define PCA9622_ARRAY_MAX_BUSES 1
+#endif
+#else
+#ifndef PCA9622_ARRAY_MAX_DEVICES
+#define PCA9622_ARRAY_MAX_DEVICES 32
+#endif
+#ifndef PCA9622_ARRAY_MAX_BUSES
+#define PCA9622_ARRAY_MAX_BUSES 4
+#endif
+#endif
+
+#define PCA9622_OUTPUT_COUNT    16 // Outputs per device, the framebuffer holds this amount of bytes per device
+#define PCA9622_SCALE_NONE      256 // Current scale factor (8.8 fixed point) that leaves the PWM values unchanged
+
+/**
+ * @brief Framebuffer for a fixture of multiple PCA9622 devices. 
+ * Changes are collected in the framebuffer and written with a single transaction per device on @ref flush
+ * 
+ */
+class PCA9622Array
+{
+public:
+    PCA9622Array(PCA9622 *devices, uint8_t deviceCount, uint8_t *framebuffer); // Constructor
+
+    /**
+     * Initialisation functions
+     */
+    bool begin();
+#ifndef PCA9622_LOW_FOOTPRINT
+    bool beginAsync();
+    bool wakeUpAsync();
+    bool poll(uint32_t now = micros());
+    bool isBusy();
+#endif
+    uint8_t getDeviceCount();
+    PCA9622 &getDevice(uint8_t device);
+
+    /**
+     * Framebuffer functions
+     */
+    void setPWM(uint8_t device, uint8_t output, uint8_t value);
+    uint8_t getPWM(uint8_t device, uint8_t output);
+    void fill(uint8_t value);
+    uint8_t fillBroadcast(uint8_t value, EAddressType addressType = EAddressType::AllCall);
+    uint8_t flush();
+    void prepareFlush();
+    void invalidate();
+    uint8_t flushBus(uint8_t bus);
+
+    void setGroupPWM(uint8_t value);
+
+    /**
+     * Group blinking functions
+     */
+    uint16_t setGroupBlinking(uint16_t ms, uint8_t dutyCycle, EAddressType addressType = EAddressType::AllCall);
+    void resyncGroupBlinking(EAddressType addressType = EAddressType::AllCall);
+    void setBlinkResyncInterval(uint32_t ms);
+    void update();
+
+    /**
+     * Bus functions
+     */
+    bool setDeviceBus(uint8_t device, TwoWire *bus);
+    uint8_t getDeviceBus(uint8_t device);
+    uint8_t getBusCount();
+    TwoWire *getBus(uint8_t bus);
+    uint32_t getBusFrameTime(uint8_t bus);
+    uint16_t getBusFrameBytes(uint8_t bus);
+
+    /**
+     * Current budget functions
+     */
+    void setChannelCurrent(uint8_t mA);
+    void setCurrentBudget(uint32_t mA);
+    uint32_t getEstimatedCurrent();
+    uint16_t getCurrentScale();
+
+#ifndef PCA9622_LOW_FOOTPRINT
+    /**
+     * Verification functions
+     */
+    void setVerification(uint8_t budgetPercent, uint8_t windowSize = 8);
+    uint8_t verifyNext();
+    uint16_t getRepairCount();
+#endif
+
+protected:
+private:
+    PCA9622 *_devices;
+    uint8_t _device_count;
+    uint8_t _left_out = 0; // Devices given to the constructor that did not fit
+    uint8_t *_framebuffer;
+    uint16_t _dirty[PCA9622_ARRAY_MAX_DEVICES]; // One bit per output that changed since the last flush
+    uint8_t _device_bus[PCA9622_ARRAY_MAX_DEVICES]; // Index in _buses per device
+
+    TwoWire *_buses[PCA9622_ARRAY_MAX_BUSES];
+    uint8_t _bus_count = 0;
+    uint32_t _bus_frame_time[PCA9622_ARRAY_MAX_BUSES]; // Duration of the last flush per bus in us
+    uint16_t _bus_frame_bytes[PCA9622_ARRAY_MAX_BUSES]; // Bytes written in the last flush per bus
+
+    uint32_t _pwm_sum = 0; // Sum of all PWM values in the framebuffer
+    uint8_t _group_pwm = 0xFF; // GRPPWM power up value
+    uint8_t _channel_current = 0; // 0: current budget disabled
+    uint32_t _current_budget = 0; // 0: current budget disabled
+    uint16_t _applied_scale = PCA9622_SCALE_NONE;
+
+    uint32_t _resync_interval = 0; // 0: periodic resync disabled
+    uint32_t _last_resync = 0;
+    EAddressType _resync_address_type = EAddressType::AllCall;
+
+#ifndef PCA9622_LOW_FOOTPRINT
+    uint8_t _verify_budget = 0; // Percentage of the bus time, 0: background verification disabled
+    uint8_t _verify_window_size = 8;
+    uint8_t _verify_device = 0; // Next device to verify
+    uint8_t _verify_register = PCA9622_MODE1; // First register of the next window, MODE1 is verified on its own
+    uint32_t _verify_next = 0;
+    uint16_t _repair_count = 0;
+#endif
+
+    uint8_t flushDevice(uint8_t device, uint16_t *bytes);
+    uint32_t estimateCurrent(uint32_t *fullOn);
+    int8_t addBus(TwoWire *bus);
+    int8_t getBusDevice(uint8_t bus);
+#ifndef PCA9622_LOW_FOOTPRINT
+    void trackBusWrite(uint8_t bus, uint8_t startAddress, uint8_t value, uint8_t count);
+    uint8_t verifyStep(uint16_t *bytes);
+#endif
+};
+
+#endif
@@ -0,0 +1,484 @@
+/**
+ * @file PCA9622Effects.cpp
+ * @author rneurink (ruben.neurink@gmail.com)
+ * @brief Animation effects for the framebuffer of a PCA9622Array
+ * @version 1.1.0
+ * @date 2026-10-18
+ * 
+ * @copyright Copyright (c) 2021
+ * 
+ */
+#include "PCA9622Effects.h"
+
+/**
+ * @brief Construct a new effect on a range of pixels
+ * 
+ * @param firstPixel The first pixel of the effect
+ * @param pixelCount The amount of pixels of the effect
+ */
+PCA9622Effect::PCA9622Effect(uint16_t firstPixel, uint16_t pixelCount) {
+    _first_pixel = firstPixel;
+    _pixel_count = pixelCount;
+}
+
+/**
+ * @brief Returns the first pixel of the effect
+ * 
+ * @return uint16_t The pixel
+ */
+uint16_t PCA9622Effect::getFirstPixel() {
+    return _first_pixel;
+}
+
+/**
+ * @brief Returns the amount of pixels of the effect
+ * 
+ * @return uint16_t The amount of pixels
+ */
+uint16_t PCA9622Effect::getPixelCount() {
+    return _pixel_count;
+}
+
+
+/*----------------------- Compositor functions ------------------------------*/
+
+/**
+ * @brief Construct a new effects renderer for the framebuffer of an array.
+ * A pixel is a single output, an RGB LED or an RGBA LED. The colors of a pixel are ordered with the LED configuration of the device,
+ * see @ref PCA9622::setLEDConfiguration. Single outputs show the brightest color of the pixel and the amber output of RGBA LEDs stays off. 
+ * Devices with an RGB configuration for 4 channels per pixel, or an RGBA configuration for 3 channels per pixel, get the colors in plain RGB(A) order
+ * 
+ * @param array The array to render into
+ * @param channelsPerPixel The outputs per pixel: 1 (16 pixels per device), 3 (RGB, 5 pixels per device) or 4 (RGBA, 4 pixels per device)
+ */
+PCA9622Effects::PCA9622Effects(PCA9622Array &array, uint8_t channelsPerPixel) : _array(array) {
+    if (channelsPerPixel != 3 && channelsPerPixel != 4) channelsPerPixel = 1;
+    _channels_per_pixel = channelsPerPixel;
+    _pixels_per_device = PCA9622_OUTPUT_COUNT / channelsPerPixel;
+    memset(_changed, 0, sizeof(_changed));
+}
+
+/**
+ * @brief Adds an effect on top of the effects that are already added.
+ * An effect can only be added to a single renderer
+ * 
+ * @param effect The effect
+ * @param blendMode How the effect is combined with the effects below
+ * @param alpha The opacity of the effect for @ref EBlendMode::Alpha. 255 replaces the effects below
+ */
+void PCA9622Effects::addEffect(PCA9622Effect &effect, EBlendMode blendMode, uint8_t alpha) {
+    PCA9622Effect **next = &_effects;
+    while (*next != nullptr && *next != &effect) {
+        next = &(*next)->_next;
+    }
+    if (*next == nullptr) {
+        effect._next = nullptr;
+        *next = &effect;
+    }
+    effect._blend_mode = blendMode;
+    effect._alpha = alpha;
+    invalidate(effect._first_pixel, effect._pixel_count);
+}
+
+/**
+ * @brief Removes an effect, its pixels show the effects below again
+ * 
+ * @param effect The effect
+ */
+void PCA9622Effects::removeEffect(PCA9622Effect &effect) {
+    PCA9622Effect **next = &_effects;
+    while (*next != nullptr) {
+        if (*next == &effect) {
+            *next = effect._next;
+            effect._next = nullptr;
+            invalidate(effect._first_pixel, effect._pixel_count);
+            return;
+        }
+        next = &(*next)->_next;
+    }
+}
+
+/**
+ * @brief Changes the opacity of an effect, for example to cross fade between two effects
+ * 
+ * @param effect The effect
+ * @param alpha The opacity of the effect for @ref EBlendMode::Alpha
+ */
+void PCA9622Effects::setAlpha(PCA9622Effect &effect, uint8_t alpha) {
+    if (effect._alpha == alpha) return;
+    effect._alpha = alpha;
+    invalidate(effect._first_pixel, effect._pixel_count);
+}
+
+/**
+ * @brief Returns the amount of pixels of the array
+ * 
+ * @return uint16_t The amount of pixels
+ */
+uint16_t PCA9622Effects::getPixelCount() {
+    uint16_t count = (uint16_t)_array.getDeviceCount() * _pixels_per_device;
+    return (count > PCA9622_EFFECTS_MAX_PIXELS) ? PCA9622_EFFECTS_MAX_PIXELS : count;
+}
+
+/**
+ * @brief Marks pixels to be rendered again on the next @ref update. Called by the effects for the pixels they changed
+ * 
+ * @param firstPixel The first pixel
+ * @param count The amount of pixels
+ */
+void PCA9622Effects::invalidate(uint16_t firstPixel, uint16_t count) {
+    uint16_t pixelCount = getPixelCount();
+    if (firstPixel >= pixelCount) return;
+    if (count > pixelCount - firstPixel) count = pixelCount - firstPixel;
+    for (uint16_t pixel = firstPixel; pixel < firstPixel + count; pixel++) {
+        _changed[pixel >> 3] |= (1 << (pixel & 0x07));
+    }
+}
+
+/**
+ * @brief Marks all pixels to be rendered again on the next @ref update
+ * 
+ */
+void PCA9622Effects::invalidateAll() {
+    invalidate(0, getPixelCount());
+}
+
+/**
+ * @brief Updates all effects and renders the pixels that changed into the framebuffer.
+ * Call @ref PCA9622Array::flush afterwards to write the changes to the devices
+ * 
+ * @param now The current time in ms
+ * @return uint16_t The amount of rendered pixels
+ */
+uint16_t PCA9622Effects::update(uint32_t now) {
+    for (PCA9622Effect *effect = _effects; effect != nullptr; effect = effect->_next) {
+        effect->update(*this, now);
+    }
+
+    uint16_t rendered = 0;
+    uint16_t pixelCount = getPixelCount();
+    for (uint16_t i = 0; i < (pixelCount + 7) / 8; i++) {
+        uint8_t changed = _changed[i];
+        if (changed == 0) continue;
+        _changed[i] = 0;
+        for (uint8_t bit = 0; bit < 8; bit++) {
+            if (changed & (1 << bit)) {
+                renderPixel((i << 3) + bit);
+                rendered++;
+            }
+        }
+    }
+    return rendered;
+}
+
+/**
+ * @brief Blends the effects on a pixel from the bottom to the top and writes the result to the framebuffer
+ * 
+ * @param pixel The pixel
+ */
+void PCA9622Effects::renderPixel(uint16_t pixel) {
+    uint8_t rgb[3] = {0, 0, 0};
+    uint8_t value[3];
+    for (PCA9622Effect *effect = _effects; effect != nullptr; effect = effect->_next) {
+        if (pixel < effect->_first_pixel || pixel - effect->_first_pixel >= effect->_pixel_count) continue;
+        effect->render(pixel, value);
+        for (uint8_t i = 0; i < 3; i++) {
+            rgb[i] = blend(rgb[i], value[i], effect->_blend_mode, effect->_alpha);
+        }
+    }
+
+    uint8_t device = pixel / _pixels_per_device;
+    uint8_t output = (pixel % _pixels_per_device) * _channels_per_pixel;
+    if (_channels_per_pixel == 1) {
+        uint8_t brightest = rgb[0];
+        if (rgb[1] > brightest) brightest = rgb[1];
+        if (rgb[2] > brightest) brightest = rgb[2];
+        _array.setPWM(device, output, brightest);
+        return;
+    }
+
+    // Plain RGB order with the amber off when the LED configuration of the device has another amount of channels than the pixel
+    uint8_t buffer[4] = {rgb[0], rgb[1], rgb[2], 0};
+    PCA9622 &target = _array.getDevice(device);
+    uint8_t deviceChannels = (target.getLEDCount() == 5) ? 3 : 4;
+    if (deviceChannels == _channels_per_pixel) {
+        if (_channels_per_pixel == 3) {
+            target.fillLEDbuffer(rgb[0], rgb[1], rgb[2], buffer);
+        } else {
+            target.fillLEDbuffer(rgb[0], rgb[1], rgb[2], 0, buffer);
+        }
+    }
+    for (uint8_t i = 0; i < _channels_per_pixel; i++) {
+        _array.setPWM(device, output + i, buffer[i]);
+    }
+}
+
+/**
+ * @brief Combines a color channel of an effect with the layers below
+ * 
+ * @param below The value of the layers below
+ * @param value The value of the effect
+ * @param blendMode How the values are combined
+ * @param alpha The opacity of the effect for @ref EBlendMode::Alpha
+ * @return uint8_t The combined value
+ */
+uint8_t PCA9622Effects::blend(uint8_t below, uint8_t value, EBlendMode blendMode, uint8_t alpha) {
+    switch (blendMode) {
+        case EBlendMode::Add: {
+            uint16_t sum = (uint16_t)below + value;
+            return (sum > 0xFF) ? 0xFF : sum;
+        }
+        case EBlendMode::Max:
+            return (value > below) ? value : below;
+        case EBlendMode::Alpha: {
+            uint16_t weight = alpha + (alpha >> 7); // 0..256 so 255 fully replaces the value below
+            return ((uint16_t)value * weight + (uint16_t)below * (256 - weight)) >> 8;
+        }
+        default:
+            return value;
+    }
+}
+
+
+/*----------------------- Chase functions -----------------------------------*/
+
+/**
+ * @brief Construct a new chase effect
+ * 
+ * @param firstPixel The first pixel of the effect
+ * @param pixelCount The amount of pixels of the effect
+ * @param red The red color value from 0 to 0xFF
+ * @param green The green color value from 0 to 0xFF
+ * @param blue The blue color value from 0 to 0xFF
+ * @param stepMs The time in ms the dot stays on a pixel
+ * @param length The length of the dot and its tail in pixels
+ */
+PCA9622Chase::PCA9622Chase(uint16_t firstPixel, uint16_t pixelCount, uint8_t red, uint8_t green, uint8_t blue, uint16_t stepMs, uint8_t length) : PCA9622Effect(firstPixel, pixelCount) {
+    _color[0] = red;
+    _color[1] = green;
+    _color[2] = blue;
+    _step_ms = (stepMs == 0) ? 1 : stepMs;
+    if (length == 0) length = 1;
+    _length = (length > pixelCount) ? pixelCount : length;
+}
+
+/**
+ * @brief Moves the dot and invalidates the pixels of the tail before and after the move
+ * 
+ * @param effects The renderer of the effect
+ * @param now The current time in ms
+ */
+void PCA9622Chase::update(PCA9622Effects &effects, uint32_t now) {
+    if (_pixel_count == 0) return;
+    uint16_t position = (now / _step_ms) % _pixel_count;
+    if (position == _position) return;
+    if (_position != 0xFFFF) invalidateTail(effects, _position);
+    _position = position;
+    invalidateTail(effects, _position);
+}
+
+/**
+ * @brief Returns the color of a pixel. The tail fades out linearly
+ * 
+ * @param pixel The pixel
+ * @param rgb The color of the pixel
+ */
+void PCA9622Chase::render(uint16_t pixel, uint8_t *rgb) {
+    uint16_t distance = (_position + _pixel_count - (pixel - _first_pixel)) % _pixel_count;
+    uint16_t level = 0;
+    if (_position != 0xFFFF && distance < _length) {
+        level = ((uint16_t)(_length - distance) << 8) / _length;
+    }
+    for (uint8_t i = 0; i < 3; i++) {
+        rgb[i] = ((uint16_t)_color[i] * level) >> 8;
+    }
+}
+
+/**
+ * @brief Invalidates the pixels of the dot and its tail
+ * 
+ * @param effects The renderer of the effect
+ * @param position The pixel of the head of the dot
+ */
+void PCA9622Chase::invalidateTail(PCA9622Effects &effects, uint16_t position) {
+    for (uint8_t i = 0; i < _length; i++) {
+        effects.invalidate(_first_pixel + (position + _pixel_count - i) % _pixel_count);
+    }
+}
+
+
+/*----------------------- Breathe functions ---------------------------------*/
+
+/**
+ * @brief Construct a new breathe effect
+ * 
+ * @param firstPixel The first pixel of the effect
+ * @param pixelCount The amount of pixels of the effect
+ * @param red The red color value from 0 to 0xFF
+ * @param green The green color value from 0 to 0xFF
+ * @param blue The blue color value from 0 to 0xFF
+ * @param periodMs The time in ms of a fade in and out
+ */
+PCA9622Breathe::PCA9622Breathe(uint16_t firstPixel, uint16_t pixelCount, uint8_t red, uint8_t green, uint8_t blue, uint16_t periodMs) : PCA9622Effect(firstPixel, pixelCount) {
+    _color[0] = red;
+    _color[1] = green;
+    _color[2] = blue;
+    _period_ms = (periodMs == 0) ? 1 : periodMs;
+}
+
+/**
+ * @brief Updates the brightness and invalidates all pixels when it changed
+ * 
+ * @param effects The renderer of the effect
+ * @param now The current time in ms
+ */
+void PCA9622Breathe::update(PCA9622Effects &effects, uint32_t now) {
+    uint16_t phase = ((now % _period_ms) << 9) / _period_ms; // 0..511
+    uint16_t triangle = (phase < 256) ? phase : 511 - phase;
+    // Squared for a fade that looks linear to the eye
+    uint8_t level = (((triangle + 1) * (triangle + 1)) - 1) >> 8;
+    if (_started && level == _level) return;
+    _started = true;
+    _level = level;
+    effects.invalidate(_first_pixel, _pixel_count);
+}
+
+/**
+ * @brief Returns the color of a pixel
+ * 
+ * @param pixel The pixel
+ * @param rgb The color of the pixel
+ */
+void PCA9622Breathe::render(uint16_t pixel, uint8_t *rgb) {
+    (void)pixel; // All pixels have the same color
+    for (uint8_t i = 0; i < 3; i++) {
+        rgb[i] = ((uint16_t)_color[i] * (_level + 1)) >> 8;
+    }
+}
+
+
+/*----------------------- Rainbow functions ---------------------------------*/
+
+/**
+ * @brief Construct a new rainbow effect
+ * 
+ * @param firstPixel The first pixel of the effect
+ * @param pixelCount The amount of pixels of the effect
+ * @param periodMs The time in ms for the hue to go around once
+ * @param hueStep The hue difference between two pixels
+ * @param saturation The saturation from 0 to 0xFF
+ * @param value The brightness from 0 to 0xFF
+ */
+PCA9622Rainbow::PCA9622Rainbow(uint16_t firstPixel, uint16_t pixelCount, uint16_t periodMs, uint8_t hueStep, uint8_t saturation, uint8_t value) : PCA9622Effect(firstPixel, pixelCount) {
+    _period_ms = (periodMs == 0) ? 1 : periodMs;
+    _hue_step = hueStep;
+    _saturation = saturation;
+    _value = value;
+}
+
+/**
+ * @brief Moves the hue and invalidates all pixels when it changed
+ * 
+ * @param effects The renderer of the effect
+ * @param now The current time in ms
+ */
+void PCA9622Rainbow::update(PCA9622Effects &effects, uint32_t now) {
+    uint8_t hue = ((now % _period_ms) << 8) / _period_ms;
+    if (_started && hue == _hue) return;
+    _started = true;
+    _hue = hue;
+    effects.invalidate(_first_pixel, _pixel_count);
+}
+
+/**
+ * @brief Returns the color of a pixel. See @ref PCA9622::hsvToRGB
+ * 
+ * @param pixel The pixel
+ * @param rgb The color of the pixel
+ */
+void PCA9622Rainbow::render(uint16_t pixel, uint8_t *rgb) {
+    uint8_t hue = _hue + (uint8_t)((pixel - _first_pixel) * _hue_step);
+    PCA9622::hsvToRGB(hue, _saturation, _value, rgb);
+}
+
+
+/*----------------------- Sparkle functions ---------------------------------*/
+
+/**
+ * @brief Construct a new sparkle effect. The random pixels are the same for every seed, so an animation can be repeated
+ * 
+ * @param firstPixel The first pixel of the effect
+ * @param pixelCount The amount of pixels of the effect
+ * @param red The red color value from 0 to 0xFF
+ * @param green The green color value from 0 to 0xFF
+ * @param blue The blue color value from 0 to 0xFF
+ * @param chance The chance from 0 to 0xFF that a new sparkle starts every step
+ * @param fade The brightness that a sparkle loses every step
+ * @param stepMs The time in ms between two steps
+ * @param seed The start value of the random generator
+ */
+PCA9622Sparkle::PCA9622Sparkle(uint16_t firstPixel, uint16_t pixelCount, uint8_t red, uint8_t green, uint8_t blue, uint8_t chance, uint8_t fade, uint16_t stepMs, uint16_t seed) : PCA9622Effect(firstPixel, pixelCount) {
+    _color[0] = red;
+    _color[1] = green;
+    _color[2] = blue;
+    _chance = chance;
+    _fade = (fade == 0) ? 1 : fade;
+    _step_ms = (stepMs == 0) ? 1 : stepMs;
+    _random = (seed == 0) ? 0xACE1 : seed;
+    memset(_levels, 0, sizeof(_levels));
+}
+
+/**
+ * @brief Fades the active sparkles and starts a new sparkle by chance. Only the pixels of the sparkles are invalidated
+ * 
+ * @param effects The renderer of the effect
+ * @param now The current time in ms
+ */
+void PCA9622Sparkle::update(PCA9622Effects &effects, uint32_t now) {
+    if (_pixel_count == 0 || now - _last_step < _step_ms) return;
+    _last_step = now;
+
+    int8_t slot = -1;
+    for (uint8_t i = 0; i < PCA9622_SPARKLE_MAX; i++) {
+        if (_levels[i] == 0) {
+            slot = i;
+            continue;
+        }
+        _levels[i] = (_levels[i] > _fade) ? _levels[i] - _fade : 0;
+        effects.invalidate(_pixels[i]);
+    }
+
+    if (slot >= 0 && (nextRandom() & 0xFF) < _chance) {
+        _pixels[slot] = _first_pixel + (nextRandom() % _pixel_count);
+        _levels[slot] = 0xFF;
+        effects.invalidate(_pixels[slot]);
+    }
+}
+
+/**
+ * @brief Returns the color of a pixel, the brightest sparkle on the pixel
+ * 
+ * @param pixel The pixel
+ * @param rgb The color of the pixel
+ */
+void PCA9622Sparkle::render(uint16_t pixel, uint8_t *rgb) {
+    uint8_t level = 0;
+    for (uint8_t i = 0; i < PCA9622_SPARKLE_MAX; i++) {
+        if (_levels[i] > level && _pixels[i] == pixel) level = _levels[i];
+    }
+    for (uint8_t i = 0; i < 3; i++) {
+        rgb[i] = ((uint16_t)_color[i] * (level + 1)) >> 8;
+    }
+}
+
+/**
+ * @brief Returns the next value of a 16 bit xorshift random generator
+ * 
+ * @return uint16_t The random value
+ */
+uint16_t PCA9622Sparkle::nextRandom() {
+    _random ^= _random << 7;
+    _random ^= _random >> 9;
+    _random ^= _random << 8;
+    return _random;
+}
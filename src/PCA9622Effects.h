@@ -0,0 +1,178 @@
+/**
+ * @file PCA9622Effects.h
+ * @author rneurink (ruben.neurink@gmail.com)
+ * @brief Animation effects for the framebuffer of a PCA9622Array
+ * @version 1.1.0
+ * @date 2026-10-18
+ * 
+ * @copyright Copyright (c) 2021
+ * 
+ */
+
+#ifndef __PCA9622_EFFECTS_H
+#define __PCA9622_EFFECTS_H
+
+#include <Arduino.h>
+#include "PCA9622.h"
+#include "PCA9622Array.h"
+
+#define PCA9622_EFFECTS_MAX_PIXELS  (PCA9622_ARRAY_MAX_DEVICES * PCA9622_OUTPUT_COUNT) // Pixels when every output is a pixel
+#define PCA9622_SPARKLE_MAX         8 // Sparkles that can be active at the same time per sparkle effect
+
+enum EBlendMode {
+    Add,    // Adds the effect to the layers below, clipped at 255
+    Max,    // The highest value of the effect and the layers below
+    Alpha   // Mixes the effect over the layers below with the alpha of the layer
+};
+
+class PCA9622Effects;
+
+/**
+ * @brief Base class of an effect on a range of pixels.
+ * An effect updates its state on every tick and invalidates the pixels that changed, only those pixels are rendered again
+ * 
+ */
+class PCA9622Effect
+{
+public:
+    PCA9622Effect(uint16_t firstPixel, uint16_t pixelCount);
+
+    virtual void update(PCA9622Effects &effects, uint32_t now) = 0;
+    virtual void render(uint16_t pixel, uint8_t *rgb) = 0;
+
+    uint16_t getFirstPixel();
+    uint16_t getPixelCount();
+
+protected:
+    uint16_t _first_pixel;
+    uint16_t _pixel_count;
+
+private:
+    friend class PCA9622Effects;
+    EBlendMode _blend_mode = EBlendMode::Max;
+    uint8_t _alpha = 255;
+    PCA9622Effect *_next = nullptr;
+};
+
+/**
+ * @brief Renders layers of effects into the framebuffer of a PCA9622Array.
+ * Only the pixels that changed during a tick are blended and written to the framebuffer,
+ * so with @ref PCA9622Array::flush the CPU and bus time scale with the changed pixels instead of the fixture size
+ * 
+ */
+class PCA9622Effects
+{
+public:
+    PCA9622Effects(PCA9622Array &array, uint8_t channelsPerPixel = 1); // Constructor
+
+    void addEffect(PCA9622Effect &effect, EBlendMode blendMode = EBlendMode::Max, uint8_t alpha = 255);
+    void removeEffect(PCA9622Effect &effect);
+    void setAlpha(PCA9622Effect &effect, uint8_t alpha);
+
+    uint16_t getPixelCount();
+    void invalidate(uint16_t firstPixel, uint16_t count = 1);
+    void invalidateAll();
+    uint16_t update(uint32_t now = millis());
+
+protected:
+private:
+    PCA9622Array &_array;
+    uint8_t _channels_per_pixel;
+    uint8_t _pixels_per_device;
+    PCA9622Effect *_effects = nullptr;
+    uint8_t _changed[(PCA9622_EFFECTS_MAX_PIXELS + 7) / 8]; // One bit per pixel that has to be rendered again
+
+    void renderPixel(uint16_t pixel);
+    static uint8_t blend(uint8_t below, uint8_t value, EBlendMode blendMode, uint8_t alpha);
+};
+
+
+/*----------------------- Effects -------------------------------------------*/
+
+/**
+ * @brief A dot of a single color with a fading tail that moves along the pixels
+ * 
+ */
+class PCA9622Chase : public PCA9622Effect
+{
+public:
+    PCA9622Chase(uint16_t firstPixel, uint16_t pixelCount, uint8_t red, uint8_t green, uint8_t blue, uint16_t stepMs, uint8_t length = 1);
+
+    void update(PCA9622Effects &effects, uint32_t now) override;
+    void render(uint16_t pixel, uint8_t *rgb) override;
+
+private:
+    uint8_t _color[3];
+    uint16_t _step_ms;
+    uint8_t _length;
+    uint16_t _position = 0xFFFF; // Pixel of the head, 0xFFFF before the first update
+
+    void invalidateTail(PCA9622Effects &effects, uint16_t position);
+};
+
+/**
+ * @brief All pixels fade in and out with the same color
+ * 
+ */
+class PCA9622Breathe : public PCA9622Effect
+{
+public:
+    PCA9622Breathe(uint16_t firstPixel, uint16_t pixelCount, uint8_t red, uint8_t green, uint8_t blue, uint16_t periodMs);
+
+    void update(PCA9622Effects &effects, uint32_t now) override;
+    void render(uint16_t pixel, uint8_t *rgb) override;
+
+private:
+    uint8_t _color[3];
+    uint16_t _period_ms;
+    uint8_t _level = 0;
+    bool _started = false;
+};
+
+/**
+ * @brief The hue moves along the pixels
+ * 
+ */
+class PCA9622Rainbow : public PCA9622Effect
+{
+public:
+    PCA9622Rainbow(uint16_t firstPixel, uint16_t pixelCount, uint16_t periodMs, uint8_t hueStep = 16, uint8_t saturation = 255, uint8_t value = 255);
+
+    void update(PCA9622Effects &effects, uint32_t now) override;
+    void render(uint16_t pixel, uint8_t *rgb) override;
+
+private:
+    uint16_t _period_ms;
+    uint8_t _hue_step;
+    uint8_t _saturation;
+    uint8_t _value;
+    uint8_t _hue = 0;
+    bool _started = false;
+};
+
+/**
+ * @brief Random pixels light up and fade out
+ * 
+ */
+class PCA9622Sparkle : public PCA9622Effect
+{
+public:
+    PCA9622Sparkle(uint16_t firstPixel, uint16_t pixelCount, uint8_t red, uint8_t green, uint8_t blue, uint8_t chance = 32, uint8_t fade = 16, uint16_t stepMs = 20, uint16_t seed = 0xACE1);
+
+    void update(PCA9622Effects &effects, uint32_t now) override;
+    void render(uint16_t pixel, uint8_t *rgb) override;
+
+private:
+    uint8_t _color[3];
+    uint8_t _chance;
+    uint8_t _fade;
+    uint16_t _step_ms;
+    uint16_t _random;
+    uint32_t _last_step = 0;
+    uint16_t _pixels[PCA9622_SPARKLE_MAX];
+    uint8_t _levels[PCA9622_SPARKLE_MAX];
+
+    uint16_t nextRandom();
+};
+
+#endif
@@ -0,0 +1,205 @@
+/**
+ * @file PCA9622FramePlayer.cpp
+ * @author rneurink (ruben.neurink@gmail.com)
+ * @brief Player for compact delta encoded light shows stored in flash
+ * @version 1.1.0
+ * @date 2026-10-18
+ * 
+ * @copyright Copyright (c) 2021
+ * 
+ */
+#include "PCA9622FramePlayer.h"
+
+/**
+ * @brief Construct a new frame player. Device n of the show is played on devices[n],
+ * spans for devices past deviceCount are decoded but not written. With a deviceCount of 0 only the decoding is done, which is useful to measure it
+ * 
+ * @param devices The devices to play the show on
+ * @param deviceCount The amount of devices
+ */
+PCA9622FramePlayer::PCA9622FramePlayer(PCA9622 *devices, uint8_t deviceCount) {
+    _devices = devices;
+    _device_count = deviceCount;
+}
+
+/**
+ * @brief Loads a show and rewinds it to the first frame. The devices should already be initialized
+ * 
+ * @param show The show created with extras/frame_encoder.py
+ * @param progmem true when the show is stored in flash with PROGMEM, false when it is in RAM
+ * @return 0:success
+ * @return 1:not a show
+ * @return 2:unsupported version
+ * @return 3:the show length is shorter than the header
+ */
+uint8_t PCA9622FramePlayer::begin(const uint8_t *show, bool progmem) {
+    _show = nullptr;
+    _progmem = progmem;
+    _playing = false;
+    _position = show;
+    _end = show + PCA9622_FRAME_HEADER_SIZE;
+    if (readByte() != 'P' || readByte() != 'F') return 1;
+    if (readByte() != PCA9622_FRAME_VERSION) return 2;
+    _show_device_count = readByte();
+    _frame_period = readByte();
+    _frame_period |= (uint16_t)readByte() << 8;
+    uint32_t length = 0;
+    for (uint8_t i = 0; i < 4; i++) {
+        length |= (uint32_t)readByte() << (i * 8);
+    }
+    if (length < PCA9622_FRAME_HEADER_SIZE) return 3;
+    _show = show;
+    _end = show + length;
+    rewind();
+    return 0;
+}
+
+/**
+ * @brief Restarts the show at the first frame. The first frame holds all registers, so it restores the devices from any state
+ * 
+ */
+void PCA9622FramePlayer::rewind() {
+    if (_show == nullptr) return;
+    _position = _show + PCA9622_FRAME_HEADER_SIZE;
+    _playing = true;
+    _timing = false;
+    _frame = 0;
+    _error = 0;
+}
+
+/**
+ * @brief Decodes the next frame and writes every changed span in a single write
+ * 
+ * @return uint8_t The amount of frame periods to show the frame, 0 when the show ended or is corrupt
+ */
+uint8_t PCA9622FramePlayer::nextFrame() {
+    if (!_playing) return 0;
+
+    uint8_t device = 0;
+    while (true) {
+        uint8_t command = readByte();
+        uint8_t count = (command & 0x3F) + 1;
+
+        switch (command & 0xC0) {
+        case PCA9622_FRAME_HOLD:
+            _frame += count;
+            return count;
+        case PCA9622_FRAME_RUN: {
+            uint8_t start = readByte();
+            uint8_t value = readByte();
+            if (!_playing || start + count > PCA9622_FRAME_MAX_SPAN) break;
+            if (device < _device_count) {
+                uint8_t retVal = _devices[device].writeRepeatRegister(start | PCA9622_AI_ALL, value, count);
+                if (_error == 0) _error = retVal;
+            }
+            continue;
+        }
+        case PCA9622_FRAME_LITERAL: {
+            uint8_t start = readByte();
+            if (start + count > PCA9622_FRAME_MAX_SPAN) break;
+            uint8_t buffer[PCA9622_FRAME_MAX_SPAN];
+            for (uint8_t i = 0; i < count; i++) {
+                buffer[i] = readByte();
+            }
+            if (!_playing) break;
+            if (device < _device_count) {
+                uint8_t retVal = _devices[device].writeMultiRegister(start | PCA9622_AI_ALL, buffer, count);
+                if (_error == 0) _error = retVal;
+            }
+            continue;
+        }
+        default: // Control commands
+            if (command == PCA9622_FRAME_DEVICE) {
+                device = readByte();
+                if (_playing) continue;
+            }
+            break; // End of the show or an unknown command
+        }
+
+        _playing = false;
+        return 0;
+    }
+}
+
+/**
+ * @brief Plays the show in real time, call this as often as possible from the loop. Frames that are late are decoded right away,
+ * the timing stays on the frame period so the show catches up
+ * 
+ * @param now The current time in ms
+ * @return true The show is playing
+ * @return false The show ended, see @ref rewind to play it again
+ */
+bool PCA9622FramePlayer::update(uint32_t now) {
+    if (!_playing) return false;
+    if (!_timing) {
+        _next_frame = now;
+        _timing = true;
+    }
+    if ((int32_t)(now - _next_frame) < 0) return true;
+
+    uint8_t periods = nextFrame();
+    _next_frame += (uint32_t)periods * _frame_period;
+    return _playing;
+}
+
+/**
+ * @brief Returns if the show is playing
+ * 
+ * @return true The show has frames left
+ * @return false No show is loaded or the show ended
+ */
+bool PCA9622FramePlayer::isPlaying() {
+    return _playing;
+}
+
+/**
+ * @brief Returns the frame period of the show
+ * 
+ * @return uint16_t The frame period in ms
+ */
+uint16_t PCA9622FramePlayer::getFramePeriod() {
+    return _frame_period;
+}
+
+/**
+ * @brief Returns the amount of devices the show was encoded for
+ * 
+ * @return uint8_t The amount of devices
+ */
+uint8_t PCA9622FramePlayer::getShowDeviceCount() {
+    return _show_device_count;
+}
+
+/**
+ * @brief Returns the amount of frames that were decoded since the show started. 
+ * A frame that is shown for n frame periods counts as n frames, so this is the number of the next frame at the frame period
+ * 
+ * @return uint32_t The amount of frames
+ */
+uint32_t PCA9622FramePlayer::getFrame() {
+    return _frame;
+}
+
+/**
+ * @brief Returns the first I2C error since the show started
+ * 
+ * @return uint8_t 0:no error, other: the I2C error, see @ref PCA9622::writeMultiRegister
+ */
+uint8_t PCA9622FramePlayer::getError() {
+    return _error;
+}
+
+/**
+ * @brief Reads the next byte of the show from flash or RAM. Past the show length the show stops playing and the end command is returned
+ * 
+ * @return uint8_t The byte
+ */
+uint8_t PCA9622FramePlayer::readByte() {
+    if (_position >= _end) {
+        _playing = false;
+        return PCA9622_FRAME_END;
+    }
+    uint8_t value = _progmem ? pgm_read_byte(_position) : *_position;
+    _position++;
+    return value;
+}
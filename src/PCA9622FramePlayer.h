@@ -0,0 +1,81 @@
+/**
+ * @file PCA9622FramePlayer.h
+ * @author rneurink (ruben.neurink@gmail.com)
+ * @brief Player for compact delta encoded light shows stored in flash
+ * @version 1.1.0
+ * @date 2026-10-18
+ * 
+ * @copyright Copyright (c) 2021
+ * 
+ */
+
+#ifndef __PCA9622_FRAME_PLAYER_H
+#define __PCA9622_FRAME_PLAYER_H
+
+#include <Arduino.h>
+#include "PCA9622.h"
+
+/**
+ * Show format, created with extras/frame_encoder.py
+ * Header: 'P', 'F', version, device count, frame period in ms (16 bit little endian), show length in bytes including the header (32 bit little endian)
+ * Every frame only holds the registers that changed since the previous frame, the first frame holds all registers.
+ * A frame starts at device 0 and is a list of commands:
+ *  0x00            End of the show
+ *  0x01 d          Following spans are for device d
+ *  0x40 | (n - 1)  Literal span: start register followed by n values
+ *  0x80 | (n - 1)  Run: start register followed by a value that is written to n registers
+ *  0xC0 | (n - 1)  End of the frame, show it for n frame periods
+ * Spans stay within the registers 0x00..0x1B. The player stops at the show length, also when the end command is missing
+ */
+#define PCA9622_FRAME_VERSION       2
+#define PCA9622_FRAME_HEADER_SIZE   10
+#define PCA9622_FRAME_END           0x00
+#define PCA9622_FRAME_DEVICE        0x01
+#define PCA9622_FRAME_LITERAL       0x40
+#define PCA9622_FRAME_RUN           0x80
+#define PCA9622_FRAME_HOLD          0xC0
+#define PCA9622_FRAME_MAX_SPAN      (PCA9622_ALL_CALL + 1) // A span can write all registers
+
+/**
+ * @brief Plays a delta encoded light show on a set of devices.
+ * Changed register spans are decoded straight into a single write per span with constant memory use
+ * 
+ */
+class PCA9622FramePlayer
+{
+public:
+    PCA9622FramePlayer(PCA9622 *devices, uint8_t deviceCount); // Constructor
+
+    uint8_t begin(const uint8_t *show, bool progmem = true);
+    void rewind();
+    uint8_t nextFrame();
+    bool update(uint32_t now = millis());
+
+    bool isPlaying();
+    uint16_t getFramePeriod();
+    uint8_t getShowDeviceCount();
+    uint32_t getFrame();
+    uint8_t getError();
+
+protected:
+private:
+    PCA9622 *_devices;
+    uint8_t _device_count;
+
+    const uint8_t *_show = nullptr;
+    const uint8_t *_position = nullptr;
+    const uint8_t *_end = nullptr; // First byte after the show
+    bool _progmem = true;
+    uint16_t _frame_period = 0;
+    uint8_t _show_device_count = 0;
+
+    bool _playing = false;
+    bool _timing = false; // The time of the next frame is set
+    uint32_t _next_frame = 0;
+    uint32_t _frame = 0;
+    uint8_t _error = 0;
+
+    uint8_t readByte();
+};
+
+#endif
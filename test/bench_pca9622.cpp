@@ -0,0 +1,168 @@
+/**
+ * @file bench_pca9622.cpp
+ * @brief Throughput of the hot helpers on the host, in calls per second including the mock bus.
+ * The I2C transactions and bytes per call are deterministic and checked against a limit, a higher bus cost fails the run.
+ * Usage: bench_pca9622 [--save FILE] [--compare FILE] [--tolerance PERCENT]
+ * --save stores the calls per second, --compare fails when a helper is slower than the stored run by more than the tolerance (default 25%)
+ * 
+ */
+#include "Arduino.h"
+#include "Wire.h"
+#include "PCA9622.h"
+#include "PCA9622Array.h"
+#include "PCA9622Model.h"
+#include <chrono>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define BENCH_DEVICES 8
+
+static PCA9622Model *models[BENCH_DEVICES];
+static PCA9622 devices[BENCH_DEVICES];
+static uint8_t framebuffer[BENCH_DEVICES * PCA9622_OUTPUT_COUNT];
+static PCA9622Array *fixture;
+static volatile uint32_t sink; // Keeps the results of the pure functions alive
+static uint32_t counter = 0;
+
+static void ledOutputState() { devices[0].setLEDOutputState(counter % 5, (LED_State)(counter & 0x03)); }
+static void groupFrequency() { sink += devices[0].setGroupFrequency(counter & 0x3FFF); }
+static void groupFrequencyRegister() { sink += PCA9622::groupFrequencyRegister(counter) + PCA9622::groupFrequencyPeriod(counter); }
+static void pwmOutput() { devices[0].setPWMOutput(counter & 0x0F, counter); }
+static void ledColor() { devices[0].setLEDColor(counter % 5, counter, counter >> 1, counter >> 2); }
+static void allLEDColor() { devices[0].setAllLEDColor(counter, counter >> 1, counter >> 2); }
+static void ledColorsHSV() {
+    uint8_t hsv[15];
+    for (uint8_t i = 0; i < 15; i++) hsv[i] = counter + i * 17;
+    devices[0].setLEDColorsHSV(0, hsv, 5);
+}
+static void hsvToRGB() {
+    uint8_t rgb[3];
+    PCA9622::hsvToRGB(counter, 0xFF - counter, counter >> 1, rgb);
+    sink += rgb[0] + rgb[1] + rgb[2];
+}
+static void kelvinToRGB() {
+    uint8_t rgb[3];
+    PCA9622::kelvinToRGB(PCA9622_KELVIN_MIN + (counter % (PCA9622_KELVIN_MAX - PCA9622_KELVIN_MIN)), 0xFF, rgb);
+    sink += rgb[0] + rgb[1] + rgb[2];
+}
+static void arrayFlush() {
+    for (uint8_t d = 0; d < BENCH_DEVICES; d++) {
+        for (uint8_t i = 0; i < PCA9622_OUTPUT_COUNT; i++) fixture->setPWM(d, i, counter + i);
+    }
+    fixture->flush();
+}
+
+struct Benchmark {
+    const char *name;
+    void (*function)();
+    uint32_t maxTransactions; // Per call
+    uint32_t maxBytes; // Per call
+    double callsPerSecond;
+};
+
+static Benchmark benchmarks[] = {
+    {"setLEDOutputState", ledOutputState, 3, 13, 0},
+    {"setGroupFrequency", groupFrequency, 1, 3, 0},
+    {"groupFrequencyRegister", groupFrequencyRegister, 0, 0, 0},
+    {"setPWMOutput", pwmOutput, 1, 3, 0},
+    {"setLEDColor", ledColor, 1, 5, 0},
+    {"setAllLEDColor", allLEDColor, 1, 17, 0},
+    {"setLEDColorsHSV", ledColorsHSV, 1, 17, 0},
+    {"hsvToRGB", hsvToRGB, 0, 0, 0},
+    {"kelvinToRGB", kelvinToRGB, 0, 0, 0},
+    {"PCA9622Array::flush", arrayFlush, BENCH_DEVICES, BENCH_DEVICES * 18, 0},
+};
+#define BENCHMARK_COUNT (sizeof(benchmarks) / sizeof(benchmarks[0]))
+
+static double lookup(const char *path, const char *name) {
+    FILE *file = fopen(path, "r");
+    if (file == nullptr) return 0;
+    char line[128];
+    double value = 0;
+    while (fgets(line, sizeof(line), file)) {
+        char stored[64];
+        double callsPerSecond;
+        if (sscanf(line, "%63s %lf", stored, &callsPerSecond) == 2 && strcmp(stored, name) == 0) value = callsPerSecond;
+    }
+    fclose(file);
+    return value;
+}
+
+int main(int argc, char **argv) {
+    const char *save = nullptr;
+    const char *compare = nullptr;
+    double tolerance = 25;
+    for (int i = 1; i + 1 < argc; i += 2) {
+        if (strcmp(argv[i], "--save") == 0) save = argv[i + 1];
+        else if (strcmp(argv[i], "--compare") == 0) compare = argv[i + 1];
+        else if (strcmp(argv[i], "--tolerance") == 0) tolerance = atof(argv[i + 1]);
+    }
+
+    mock_reset();
+    for (uint8_t d = 0; d < BENCH_DEVICES; d++) {
+        models[d] = new PCA9622Model(0x10 + d * 2);
+        Wire.attach(models[d]);
+        devices[d].setI2CAddress(0x10 + d * 2);
+    }
+    static PCA9622Array array(devices, BENCH_DEVICES, framebuffer);
+    fixture = &array;
+    fixture->begin();
+
+    int result = 0;
+    printf("%-24s %14s %14s %10s\n", "helper", "calls/s", "transactions", "bytes");
+    for (uint8_t b = 0; b < BENCHMARK_COUNT; b++) {
+        Benchmark &benchmark = benchmarks[b];
+        // Bus cost of a single call
+        Wire.resetCounters();
+        counter++;
+        benchmark.function();
+        uint32_t transactions = Wire.transactions;
+        uint32_t bytes = Wire.bytes;
+
+        // Calls per second, measured for at least 200ms
+        uint32_t calls = 0;
+        auto start = std::chrono::steady_clock::now();
+        double elapsed = 0;
+        do {
+            for (uint16_t i = 0; i < 1000; i++) {
+                counter++;
+                benchmark.function();
+            }
+            calls += 1000;
+            elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        } while (elapsed < 0.2);
+        benchmark.callsPerSecond = calls / elapsed;
+
+        printf("%-24s %14.0f %14u %10u", benchmark.name, benchmark.callsPerSecond, transactions, bytes);
+        if (transactions > benchmark.maxTransactions || bytes > benchmark.maxBytes) {
+            printf("  FAIL bus cost above %u transactions, %u bytes", benchmark.maxTransactions, benchmark.maxBytes);
+            result = 1;
+        }
+        if (compare != nullptr) {
+            double stored = lookup(compare, benchmark.name);
+            if (stored > 0) {
+                double change = (benchmark.callsPerSecond - stored) * 100 / stored;
+                printf("  %+.0f%%", change);
+                if (change < -tolerance) {
+                    printf(" FAIL slower than %s", compare);
+                    result = 1;
+                }
+            }
+        }
+        printf("\n");
+    }
+
+    if (save != nullptr) {
+        FILE *file = fopen(save, "w");
+        if (file == nullptr) {
+            printf("cannot write %s\n", save);
+            return 1;
+        }
+        for (uint8_t b = 0; b < BENCHMARK_COUNT; b++) {
+            fprintf(file, "%s %.0f\n", benchmarks[b].name, benchmarks[b].callsPerSecond);
+        }
+        fclose(file);
+    }
+    return result;
+}
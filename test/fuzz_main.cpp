@@ -0,0 +1,60 @@
+/**
+ * @file fuzz_main.cpp
+ * @brief Runs the fuzz target without libFuzzer: replays the given files (for example a crash or a corpus) 
+ * or runs random inputs. Usage: fuzz_pca9622 [-runs=N] [-seed=N] [file...]
+ * 
+ */
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+extern "C" int LLVMFuzzerTestOneInput(const uint8_t *data, size_t size);
+
+static int runFile(const char *path) {
+    FILE *file = fopen(path, "rb");
+    if (file == nullptr) {
+        printf("cannot open %s\n", path);
+        return 1;
+    }
+    static uint8_t data[1 << 16];
+    size_t size = fread(data, 1, sizeof(data), file);
+    fclose(file);
+    LLVMFuzzerTestOneInput(data, size);
+    return 0;
+}
+
+int main(int argc, char **argv) {
+    unsigned long runs = 10000;
+    unsigned long seed = 1;
+    int files = 0;
+    for (int i = 1; i < argc; i++) {
+        if (strncmp(argv[i], "-runs=", 6) == 0) {
+            runs = strtoul(argv[i] + 6, nullptr, 10);
+        } else if (strncmp(argv[i], "-seed=", 6) == 0) {
+            seed = strtoul(argv[i] + 6, nullptr, 10);
+        } else {
+            if (runFile(argv[i]) != 0) return 1;
+            files++;
+        }
+    }
+    if (files > 0) {
+        printf("%d inputs passed\n", files);
+        return 0;
+    }
+
+    // xorshift32, the same seed gives the same inputs
+    uint32_t state = seed ? seed : 1;
+    uint8_t data[512];
+    for (unsigned long run = 0; run < runs; run++) {
+        state ^= state << 13; state ^= state >> 17; state ^= state << 5;
+        size_t size = state % sizeof(data);
+        for (size_t i = 0; i < size; i++) {
+            state ^= state << 13; state ^= state >> 17; state ^= state << 5;
+            data[i] = state;
+        }
+        LLVMFuzzerTestOneInput(data, size);
+    }
+    printf("%lu random inputs passed (seed %lu)\n", runs, seed);
+    return 0;
+}
@@ -0,0 +1,340 @@
+/**
+ * @file fuzz_pca9622.cpp
+ * @brief libFuzzer target that drives the public PCA9622 functions with the input bytes against the register model.
+ * After every call it checks that registers outside the documented range of the call stay untouched,
+ * that the register shadow of the driver matches the device, that the registers of a second device on the bus stay untouched
+ * and that the ~OE pin follows the output brightness.
+ * Build with clang++ -fsanitize=fuzzer (make fuzz) or with fuzz_main.cpp to run it without libFuzzer
+ * 
+ */
+#include "Arduino.h"
+#include "Wire.h"
+#include "PCA9622.h"
+#include "PCA9622Model.h"
+#include <stdio.h>
+#include <stdlib.h>
+
+#define FUZZ_OE_PIN 9
+
+/**
+ * @brief Reads the arguments of the calls from the input, 0 when the input is used up
+ * 
+ */
+struct FuzzInput {
+    const uint8_t *data;
+    size_t size;
+
+    bool empty() { return size == 0; }
+    uint8_t byte() {
+        if (size == 0) return 0;
+        size--;
+        return *data++;
+    }
+    uint16_t word() { return byte() | ((uint16_t)byte() << 8); }
+    uint8_t reg() { return byte() % MODEL_REGISTER_COUNT; } // Registers 0x1C..0x1F are reserved
+    uint8_t autoIncrement() {
+        uint8_t flags = byte() % 5; // No auto increment or one of the four ranges
+        return flags ? (PCA9622_AI_ALL | ((flags - 1) << 5)) : PCA9622_NO_AI;
+    }
+    LED_State state() { return (LED_State)(byte() & 0x03); }
+};
+
+static void fail(const char *call, const char *message, const uint8_t *before, const PCA9622Model &model) {
+    printf("%s: %s\n  before:", call, message);
+    for (uint8_t i = 0; i < MODEL_REGISTER_COUNT; i++) printf(" %02X", before[i]);
+    printf("\n  after: ");
+    for (uint8_t i = 0; i < MODEL_REGISTER_COUNT; i++) printf(" %02X", model.registers[i]);
+    printf("\n");
+    abort();
+}
+
+// Registers a call may change, one bit per register
+#define REG(reg)            ((uint32_t)1 << (reg))
+#define REGS(first, last)   ((((uint32_t)2 << (last)) - 1) & ~(REG(first) - 1))
+#define ALL_REGS            REGS(PCA9622_MODE1, PCA9622_ALL_CALL)
+#define PWM_REGS            REGS(PCA9622_PWM0, PCA9622_PWM0 + 15)
+#define LEDOUT_REGS         REGS(PCA9622_LED_OUT0, PCA9622_LED_OUT3)
+
+/**
+ * @brief Registers of a multi register write with auto increment
+ * 
+ */
+static uint32_t writtenRegisters(uint8_t control, uint16_t count) {
+    uint32_t changed = 0;
+    uint8_t reg = control & 0x1F;
+    for (uint16_t i = 0; i < count && i < 64; i++) {
+        changed |= REG(reg);
+        reg = PCA9622Model::nextRegister(control, reg);
+    }
+    return changed;
+}
+
+/**
+ * @brief Output registers of consecutive LEDs written by the color functions
+ * 
+ */
+static uint32_t ledRegisters(PCA9622Model &model, uint8_t rgbaConfiguration, uint8_t startLed, uint8_t count) {
+    (void)model;
+    uint8_t channels = rgbaConfiguration ? 4 : 3;
+    uint8_t ledCount = rgbaConfiguration ? 4 : 5;
+    if (startLed >= ledCount) return 0;
+    if (count > ledCount - startLed) count = ledCount - startLed;
+    return REGS(PCA9622_PWM0 + startLed * channels, PCA9622_PWM0 + (startLed + count) * channels - 1);
+}
+
+extern "C" int LLVMFuzzerTestOneInput(const uint8_t *data, size_t size) {
+    mock_reset();
+    PCA9622Model model(0xA2);
+    PCA9622Model other(0xA4);
+    Wire.attach(&model);
+    Wire.attach(&other);
+
+    PCA9622 device(0xA2, FUZZ_OE_PIN);
+    device.begin();
+    bool rgba = false;
+    bool autoSleep = false;
+    bool enabled = false; // begin disables the outputs
+
+    FuzzInput input = {data, size};
+    while (!input.empty()) {
+        uint8_t before[MODEL_REGISTER_COUNT];
+        uint8_t otherBefore[MODEL_REGISTER_COUNT];
+        memcpy(before, model.registers, sizeof(before));
+        memcpy(otherBefore, other.registers, sizeof(otherBefore));
+        bool reset = false; // The software reset resets every device on the bus
+        uint32_t allowed = 0;
+        const char *call = "";
+        uint8_t buffer[64];
+        uint8_t op = input.byte();
+
+        switch (op % 40) {
+            case 0: call = "begin"; device.begin(); allowed = REG(PCA9622_MODE1) | LEDOUT_REGS; enabled = false; break;
+            case 1: call = "softwareReset"; device.softwareReset(); allowed = ALL_REGS; reset = true; break;
+            case 2: call = "sleep"; device.sleep(); allowed = REG(PCA9622_MODE1); break;
+            case 3: call = "wakeUp"; device.wakeUp(); allowed = REG(PCA9622_MODE1); break;
+            case 4: call = "setSubAddress1"; device.setSubAddress1(input.byte() & 0xFE); allowed = REG(PCA9622_SUB_ADR1); break;
+            case 5: call = "setSubAddress2"; device.setSubAddress2(input.byte() & 0xFE); allowed = REG(PCA9622_SUB_ADR2); break;
+            case 6: call = "setSubAddress3"; device.setSubAddress3(input.byte() & 0xFE); allowed = REG(PCA9622_SUB_ADR3); break;
+            case 7: call = "setAllCallAddress"; device.setAllCallAddress(input.byte() & 0xFE); allowed = REG(PCA9622_ALL_CALL); break;
+            case 8: call = "configure"; device.configure(input.byte()); allowed = REG(PCA9622_MODE1); break;
+            case 9: call = "enableGroupDimming"; device.enableGroupDimming(); allowed = REG(PCA9622_MODE2); break;
+            case 10: call = "enableGroupBlinking"; device.enableGroupBlinking(); allowed = REG(PCA9622_MODE2); break;
+            case 11: {
+                call = "setLEDOutputState";
+                uint8_t led = input.byte() & 0x07;
+                device.setLEDOutputState(led, input.state());
+                allowed = LEDOUT_REGS;
+                break;
+            }
+            case 12: {
+                call = "setOutputState";
+                uint8_t led = input.byte();
+                device.setOutputState(led, input.state());
+                allowed = REG(PCA9622_LED_OUT0 + (led > 3 ? 3 : led));
+                break;
+            }
+            case 13: {
+                call = "setPWMOutputState";
+                uint8_t output = input.byte() & 0x1F;
+                uint8_t ledout[4];
+                memcpy(ledout, &model.registers[PCA9622_LED_OUT0], 4);
+                LED_State state = input.state();
+                device.setPWMOutputState(output, state);
+                if (output < 16) {
+                    allowed = REG(PCA9622_LED_OUT0 + output / 4);
+                    // Only the two bits of the output change
+                    uint8_t mask = 0x03 << ((output % 4) * 2);
+                    uint8_t after = model.registers[PCA9622_LED_OUT0 + output / 4];
+                    if (((after ^ ledout[output / 4]) & ~mask) != 0 || ((after & mask) >> ((output % 4) * 2)) != state) {
+                        fail(call, "other outputs changed", before, model);
+                    }
+                }
+                break;
+            }
+            case 14: call = "readRegister"; device.readRegister(input.reg()); break;
+            case 15: {
+                call = "writeRegister";
+                uint8_t reg = input.reg();
+                device.writeRegister(reg, input.byte());
+                allowed = REG(reg);
+                break;
+            }
+            case 16: {
+                call = "writeMultiRegister";
+                uint8_t control = input.reg() | input.autoIncrement();
+                uint8_t count = input.byte() % sizeof(buffer);
+                for (uint8_t i = 0; i < count; i++) buffer[i] = input.byte();
+                device.writeMultiRegister(control, buffer, count);
+                allowed = writtenRegisters(control, count);
+                break;
+            }
+            case 17: {
+                call = "writeRepeatRegister";
+                uint8_t control = input.reg() | input.autoIncrement();
+                uint8_t value = input.byte();
+                uint8_t count = input.byte() % sizeof(buffer);
+                device.writeRepeatRegister(control, value, count);
+                allowed = writtenRegisters(control, count);
+                break;
+            }
+            case 18: {
+                call = "writePatternRegister";
+                uint8_t control = input.reg() | input.autoIncrement();
+                uint8_t length = (input.byte() & 0x03) + 1;
+                for (uint8_t i = 0; i < length; i++) buffer[i] = input.byte();
+                uint8_t count = input.byte() % sizeof(buffer);
+                device.writePatternRegister(control, buffer, length, count);
+                allowed = writtenRegisters(control, count);
+                break;
+            }
+            case 19: {
+                call = "readMultiRegister";
+                uint8_t control = input.reg() | input.autoIncrement();
+                device.readMultiRegister(control, buffer, input.byte() % sizeof(buffer));
+                break;
+            }
+            case 20: call = "enableOutputs"; device.enableOutputs(); enabled = true; break;
+            case 21: call = "disableOutputs"; device.disableOutputs(); enabled = false; break;
+            case 22: {
+                call = "setOutputBrightness";
+                uint8_t brightness = input.byte();
+                device.setOutputBrightness(brightness, input.byte() & 0x01);
+                enabled = true;
+                break;
+            }
+            case 23: {
+                call = "setPWMOutput";
+                uint8_t output = input.byte() & 0x1F;
+                device.setPWMOutput(output, input.byte());
+                allowed = (output < 16) ? REG(PCA9622_PWM0 + output) : 0;
+                break;
+            }
+            case 24: call = "setAllPWMOutputs"; device.setAllPWMOutputs(input.byte()); allowed = PWM_REGS; break;
+            case 25: call = "setGroupPWM"; device.setGroupPWM(input.byte()); allowed = REG(PCA9622_GRPPWM); break;
+            case 26: call = "setGroupFrequency"; device.setGroupFrequency(input.word()); allowed = REG(PCA9622_GRPFREQ); break;
+            case 27: {
+                call = "setLEDColor";
+                uint8_t led = input.byte() & 0x07;
+                uint8_t r = input.byte(), g = input.byte(), b = input.byte();
+                if (rgba) {
+                    device.setLEDColor(led, r, g, b, input.byte());
+                    allowed = ledRegisters(model, rgba, led > 3 ? 3 : led, 1);
+                } else {
+                    device.setLEDColor(led, r, g, b);
+                    allowed = ledRegisters(model, rgba, led > 4 ? 4 : led, 1);
+                }
+                break;
+            }
+            case 28: {
+                call = "setAllLEDColor";
+                uint8_t r = input.byte(), g = input.byte(), b = input.byte();
+                if (rgba) device.setAllLEDColor(r, g, b, input.byte()); else device.setAllLEDColor(r, g, b);
+                allowed = PWM_REGS;
+                break;
+            }
+            case 29: {
+                call = "setLEDColorHSV/HSL/Temperature";
+                uint8_t led = input.byte() & 0x07;
+                uint8_t kind = input.byte() % 3;
+                uint8_t a = input.byte(), b = input.byte(), c = input.byte();
+                if (kind == 0) device.setLEDColorHSV(led, a, b, c);
+                else if (kind == 1) device.setLEDColorHSL(led, a, b, c);
+                else device.setLEDColorTemperature(led, ((uint16_t)a << 8) | b, c);
+                allowed = ledRegisters(model, rgba, led, 1);
+                break;
+            }
+            case 30: {
+                call = "setLEDColorsHSV/HSL";
+                uint8_t led = input.byte() & 0x07;
+                uint8_t count = input.byte() & 0x07;
+                bool hsl = input.byte() & 0x01;
+                for (uint8_t i = 0; i < 3 * 5; i++) buffer[i] = input.byte();
+                if (hsl) device.setLEDColorsHSL(led, buffer, count); else device.setLEDColorsHSV(led, buffer, count);
+                allowed = ledRegisters(model, rgba, led, count > 5 ? 5 : count);
+                break;
+            }
+            case 31: {
+                call = "setLEDColorsTemperature";
+                uint8_t led = input.byte() & 0x07;
+                uint8_t count = input.byte() % 6;
+                uint16_t kelvin[5];
+                for (uint8_t i = 0; i < 5; i++) kelvin[i] = input.word();
+                device.setLEDColorsTemperature(led, kelvin, input.byte(), count);
+                allowed = ledRegisters(model, rgba, led, count);
+                break;
+            }
+            case 32: {
+                call = "setLEDConfiguration";
+                uint8_t configuration = input.byte() % (ABRG + 1);
+                device.setLEDConfiguration((LED_Configuration)configuration);
+                rgba = configuration >= RGBA;
+                break;
+            }
+            case 33: call = "matchesShadow/restoreShadow"; device.restoreShadow(); allowed = REG(PCA9622_MODE1) | LEDOUT_REGS; break;
+#ifndef PCA9622_LOW_FOOTPRINT
+            case 34: {
+                call = "setAutoSleep";
+                uint16_t timeout = input.byte();
+                device.setAutoSleep(timeout);
+                autoSleep = timeout != 0;
+                break;
+            }
+            case 35: call = "disableAutoSleep"; device.disableAutoSleep(); autoSleep = false; break;
+            case 36: call = "scheduleActivity"; device.scheduleActivity(input.byte()); break;
+            case 37: {
+                call = "update";
+                mock_advance((uint32_t)input.byte() * 1000);
+                device.update();
+                allowed = REG(PCA9622_MODE1);
+                break;
+            }
+            case 38: {
+                call = "beginAsync/softwareResetAsync/wakeUpAsync";
+                uint8_t kind = input.byte() % 3;
+                if (kind == 0) {
+                    device.beginAsync();
+                    enabled = false;
+                } else if (kind == 1) {
+                    device.softwareResetAsync();
+                    reset = true;
+                } else {
+                    device.wakeUpAsync();
+                }
+                for (uint8_t i = 0; device.poll(micros() + i * 100) && i < 16; i++);
+                allowed = (kind == 1) ? ALL_REGS : REG(PCA9622_MODE1) | LEDOUT_REGS;
+                break;
+            }
+#endif
+            default: call = "probe"; PCA9622::probe(input.byte() & 0xFE); break; // Also probes the other device and the reserved addresses
+        }
+
+        // A write can wake the device up with auto sleep enabled
+        if (autoSleep) allowed |= REG(PCA9622_MODE1);
+        for (uint8_t reg = 0; reg < MODEL_REGISTER_COUNT; reg++) {
+            uint8_t changed = before[reg] ^ model.registers[reg];
+            if (reg == PCA9622_MODE1) changed &= 0x1F; // AI bits reflect the last control register
+            if (changed && !(allowed & REG(reg))) {
+                printf("register 0x%02X\n", reg);
+                fail(call, "register outside the documented range changed", before, model);
+            }
+        }
+        for (uint8_t reg = 0; reg < MODEL_REGISTER_COUNT; reg++) {
+            if (!device.matchesShadow(reg, model.registers[reg])) {
+                printf("register 0x%02X\n", reg);
+                fail(call, "register shadow differs from the device", before, model);
+            }
+        }
+        if (!reset && memcmp(otherBefore, other.registers, sizeof(otherBefore)) != 0) {
+            fail(call, "another device on the bus was written", otherBefore, other);
+        }
+        uint8_t duty = enabled ? device.getOutputBrightness() : 0;
+        MockPin &pin = mock_pins[FUZZ_OE_PIN];
+        bool pinMatches = (duty == 0xFF) ? (!pin.analog && pin.value == LOW)
+                        : (duty == 0) ? (!pin.analog && pin.value == HIGH)
+                        : (pin.analog && pin.value == 0xFF - duty);
+        if (!pinMatches) {
+            fail(call, "~OE pin does not match the output brightness", before, model);
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,108 @@
+/**
+ * @file Arduino.cpp
+ * @brief Host mock of the Arduino core
+ * 
+ */
+#include "Arduino.h"
+#include "Wire.h"
+#include <stdio.h>
+
+MockPin mock_pins[MOCK_PIN_COUNT];
+HardwareSerial Serial;
+
+static unsigned long mock_us = 0;
+static unsigned long mock_delay_us = 0;
+
+void pinMode(uint8_t pin, uint8_t mode) {
+    if (pin < MOCK_PIN_COUNT) mock_pins[pin].mode = mode;
+}
+
+void digitalWrite(uint8_t pin, uint8_t value) {
+    if (pin >= MOCK_PIN_COUNT) return;
+    mock_pins[pin].value = value;
+    mock_pins[pin].analog = false;
+}
+
+void analogWrite(uint8_t pin, int value) {
+    if (pin >= MOCK_PIN_COUNT) return;
+    mock_pins[pin].value = value;
+    mock_pins[pin].analog = true;
+}
+
+unsigned long millis() {
+    return mock_us / 1000;
+}
+
+unsigned long micros() {
+    return mock_us;
+}
+
+void delay(unsigned long ms) {
+    mock_us += ms * 1000;
+    mock_delay_us += ms * 1000;
+}
+
+void delayMicroseconds(unsigned int us) {
+    mock_us += us;
+    mock_delay_us += us;
+}
+
+void mock_reset() {
+    mock_us = 0;
+    mock_delay_us = 0;
+    memset(mock_pins, 0, sizeof(mock_pins));
+    Wire.detachAll();
+    Wire1.detachAll();
+}
+
+void mock_set_micros(unsigned long us) {
+    mock_us = us;
+}
+
+void mock_advance(unsigned long us) {
+    mock_us += us;
+}
+
+unsigned long mock_delayed() {
+    return mock_delay_us;
+}
+
+size_t Print::write(const uint8_t *buffer, size_t size) {
+    size_t written = 0;
+    while (size--) written += write(*buffer++);
+    return written;
+}
+
+size_t Print::print(const char *text) {
+    return write((const uint8_t *)text, strlen(text));
+}
+
+size_t Print::print(unsigned long value, int base) {
+    char text[34];
+    snprintf(text, sizeof(text), (base == HEX) ? "%lX" : "%lu", value);
+    return print(text);
+}
+
+size_t Print::println(const char *text) {
+    return print(text) + print("\n");
+}
+
+size_t Print::println(unsigned long value, int base) {
+    return print(value, base) + print("\n");
+}
+
+void HardwareSerial::begin(unsigned long baud) {
+    (void)baud;
+}
+
+size_t HardwareSerial::write(uint8_t data) {
+    return fputc(data, stdout) == EOF ? 0 : 1;
+}
+
+int HardwareSerial::available() {
+    return 0;
+}
+
+int HardwareSerial::read() {
+    return -1;
+}
@@ -0,0 +1,92 @@
+/**
+ * @file Arduino.h
+ * @brief Host mock of the Arduino core, just enough to build the library on a PC. 
+ * Time only advances through delay, delayMicroseconds and mock_advance, so waits of the library are measured instead of slept
+ * 
+ */
+
+#ifndef __MOCK_ARDUINO_H
+#define __MOCK_ARDUINO_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <string.h>
+
+#define HIGH    1
+#define LOW     0
+#define INPUT   0
+#define OUTPUT  1
+
+#define DEC     10
+#define HEX     16
+
+#ifndef F_CPU
+#define F_CPU   16000000UL
+#endif
+
+#define PROGMEM
+#define pgm_read_byte(address) (*(const uint8_t *)(address))
+#define pgm_read_word(address) (*(const uint16_t *)(address))
+
+typedef uint8_t byte;
+typedef bool boolean;
+
+void pinMode(uint8_t pin, uint8_t mode);
+void digitalWrite(uint8_t pin, uint8_t value);
+void analogWrite(uint8_t pin, int value);
+
+unsigned long millis();
+unsigned long micros();
+void delay(unsigned long ms);
+void delayMicroseconds(unsigned int us);
+
+class Print
+{
+public:
+    virtual ~Print() {}
+    virtual size_t write(uint8_t data) = 0;
+    virtual size_t write(const uint8_t *buffer, size_t size);
+
+    size_t print(const char *text);
+    size_t print(unsigned long value, int base = DEC);
+    size_t println(const char *text = "");
+    size_t println(unsigned long value, int base = DEC);
+};
+
+class Stream : public Print
+{
+public:
+    virtual int available() = 0;
+    virtual int read() = 0;
+};
+
+class HardwareSerial : public Stream
+{
+public:
+    void begin(unsigned long baud);
+    size_t write(uint8_t data) override;
+    int available() override;
+    int read() override;
+};
+
+extern HardwareSerial Serial;
+
+/**
+ * Mock control
+ */
+#define MOCK_PIN_COUNT 64
+
+struct MockPin {
+    uint8_t mode;
+    int value; // Digital level or analogWrite duty
+    bool analog; // Last written with analogWrite
+};
+
+extern MockPin mock_pins[MOCK_PIN_COUNT];
+
+void mock_reset(); // Time, pins and all buses
+void mock_set_micros(unsigned long us);
+void mock_advance(unsigned long us);
+unsigned long mock_delayed(); // Total time spent in delay and delayMicroseconds in us
+
+#endif
@@ -0,0 +1,114 @@
+/**
+ * @file PCA9622Model.cpp
+ * @brief Register model of a PCA9622 on the mock I2C bus
+ * 
+ */
+#include "PCA9622Model.h"
+#include <string.h>
+
+PCA9622Model::PCA9622Model(uint8_t i2c_address) {
+    address = i2c_address;
+    reset();
+}
+
+/**
+ * @brief Sets the power up values of all registers
+ * 
+ */
+void PCA9622Model::reset() {
+    memset(registers, 0, sizeof(registers));
+    registers[0x00] = 0x91; // AI2, SLEEP, ALLCALL
+    registers[0x01] = 0x05;
+    registers[0x12] = 0xFF; // GRPPWM
+    registers[0x18] = 0xE2;
+    registers[0x19] = 0xE4;
+    registers[0x1A] = 0xE8;
+    registers[0x1B] = 0xE0;
+    control = 0;
+}
+
+/**
+ * @brief Checks if the device acknowledges a 7-bit address: its own address and the enabled AllCall and SubCall addresses
+ * 
+ */
+bool PCA9622Model::respondsTo(uint8_t i2c_address) const {
+    uint8_t mode1 = registers[0x00];
+    if (i2c_address == (address >> 1)) return true;
+    if ((mode1 & 0x01) && i2c_address == (registers[0x1B] >> 1)) return true;
+    if ((mode1 & 0x08) && i2c_address == (registers[0x18] >> 1)) return true;
+    if ((mode1 & 0x04) && i2c_address == (registers[0x19] >> 1)) return true;
+    if ((mode1 & 0x02) && i2c_address == (registers[0x1A] >> 1)) return true;
+    return false;
+}
+
+/**
+ * @brief Handles a write transaction: the control register followed by the data
+ * 
+ */
+void PCA9622Model::write(const uint8_t *data, size_t length, bool broadcast) {
+    (void)broadcast;
+    writes++;
+    if (length == 0) return;
+    control = data[0];
+    uint8_t reg = control & 0x1F;
+    for (size_t i = 1; i < length; i++) {
+        uint8_t value = data[i];
+        if (reg == 0x00) {
+            // AI2..AI0 are read only and reflect the control register
+            if ((registers[0x00] & 0x10) && !(value & 0x10)) wakeUps++;
+            registers[0x00] = (value & 0x1F);
+        } else if (reg == 0x01) {
+            // Bits 7, 6 are read only 0, bits 2..0 are reserved 101
+            registers[0x01] = (value & 0x38) | 0x05;
+        } else if (reg < MODEL_REGISTER_COUNT) {
+            registers[reg] = value;
+        }
+        reg = nextRegister(control, reg);
+    }
+    registers[0x00] = (registers[0x00] & 0x1F) | (control & 0xE0);
+}
+
+/**
+ * @brief Returns the next byte of a read transaction from the register pointer
+ * 
+ */
+uint8_t PCA9622Model::read() {
+    uint8_t reg = control & 0x1F;
+    uint8_t value = (reg < MODEL_REGISTER_COUNT) ? registers[reg] : 0;
+    control = (control & 0xE0) | nextRegister(control, reg);
+    return value;
+}
+
+bool PCA9622Model::isAsleep() const {
+    return (registers[0x00] & 0x10) != 0;
+}
+
+/**
+ * @brief Returns the duty cycle of an output as set by the registers
+ * 
+ */
+uint8_t PCA9622Model::duty(uint8_t output) const {
+    if (isAsleep()) return 0;
+    uint8_t state = (registers[0x14 + (output / 4)] >> ((output % 4) * 2)) & 0x03;
+    uint8_t pwm = registers[0x02 + output];
+    switch (state) {
+        case 0x01: return 0xFF;
+        case 0x02: return pwm;
+        case 0x03: return (registers[0x01] & 0x20) ? pwm : (uint8_t)(((uint16_t)pwm * registers[0x12]) / 0xFF);
+        default: return 0;
+    }
+}
+
+/**
+ * @brief Returns the register after reg with the auto increment flags of the control register, including the roll over
+ * 
+ */
+uint8_t PCA9622Model::nextRegister(uint8_t control, uint8_t reg) {
+    switch (control & 0xE0) {
+        case 0x80: return (reg >= 0x1B) ? 0x00 : reg + 1;
+        case 0xA0: return (reg >= 0x11) ? 0x02 : reg + 1;
+        case 0xC0: return (reg >= 0x13) ? 0x12 : reg + 1;
+        case 0xE0: return (reg >= 0x13) ? 0x02 : reg + 1;
+        default: return reg; // No auto increment
+    }
+}
@@ -0,0 +1,42 @@
+/**
+ * @file PCA9622Model.h
+ * @brief Register model of a PCA9622 on the mock I2C bus, following the datasheet: 
+ * power up values, the control register with the auto increment ranges and roll over, read only bits of MODE1 and MODE2, 
+ * the AllCall and SubCall addresses and the software reset
+ * 
+ */
+
+#ifndef __PCA9622_MODEL_H
+#define __PCA9622_MODEL_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+#define MODEL_REGISTER_COUNT    0x1C
+#define MODEL_SW_RESET_ADDRESS  0x03 // 7-bit address of the software reset
+
+class PCA9622Model
+{
+public:
+    PCA9622Model(uint8_t i2c_address); // 8-bit address like the library
+
+    void reset();
+    bool respondsTo(uint8_t address) const; // 7-bit address
+    void write(const uint8_t *data, size_t length, bool broadcast);
+    uint8_t read();
+
+    bool isAsleep() const;
+    uint8_t duty(uint8_t output) const; // Duty cycle of an output from LEDOUT, PWM and GRPPWM, blinking shows the PWM value
+
+    static uint8_t nextRegister(uint8_t control, uint8_t reg);
+
+    uint8_t address; // 8-bit
+    uint8_t registers[MODEL_REGISTER_COUNT];
+    uint8_t control = 0;
+    uint32_t writes = 0; // Write transactions addressed to this device, including broadcasts
+    uint32_t reads = 0;
+    uint32_t resets = 0;
+    uint32_t wakeUps = 0; // Transitions of the SLEEP bit from 1 to 0
+};
+
+#endif
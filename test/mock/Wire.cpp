@@ -0,0 +1,133 @@
+/**
+ * @file Wire.cpp
+ * @brief Host mock of the Arduino Wire library with simulated PCA9622 devices
+ * 
+ */
+#include "Wire.h"
+#include "PCA9622Model.h"
+
+TwoWire Wire;
+TwoWire Wire1;
+
+void TwoWire::begin() {
+}
+
+void TwoWire::setClock(uint32_t frequency) {
+    clock = frequency;
+}
+
+void TwoWire::beginTransmission(uint8_t address) {
+    _address = address;
+    _tx_length = 0;
+}
+
+/**
+ * @brief Delivers the transmit buffer to every device that acknowledges the address
+ * 
+ * @return 0:success, 2:NACK on the address, 3:NACK on the data (software reset with wrong data)
+ */
+uint8_t TwoWire::endTransmission(bool sendStop) {
+    (void)sendStop;
+    transactions++;
+    transfer(_tx_length + 1);
+
+    if (_address == MODEL_SW_RESET_ADDRESS) {
+        if (_tx_length != 2 || _tx[0] != 0xA5 || _tx[1] != 0x5A) {
+            nacks++;
+            return 3;
+        }
+        for (uint8_t i = 0; i < _device_count; i++) {
+            _devices[i]->reset();
+            _devices[i]->resets++;
+        }
+        return 0;
+    }
+
+    bool acknowledged = false;
+    for (uint8_t i = 0; i < _device_count; i++) {
+        PCA9622Model *device = _devices[i];
+        if (!device->respondsTo(_address)) continue;
+        acknowledged = true;
+        device->write(_tx, _tx_length, _address != (device->address >> 1));
+    }
+    if (!acknowledged) {
+        nacks++;
+        return 2;
+    }
+    return 0;
+}
+
+/**
+ * @brief Reads from the device with the address, continuing at its register pointer
+ * 
+ * @return the amount of bytes read, 0 when no device has the address
+ */
+uint8_t TwoWire::requestFrom(uint8_t address, uint8_t quantity) {
+    transactions++;
+    transfer(quantity + 1);
+    _rx_length = 0;
+    _rx_position = 0;
+    for (uint8_t i = 0; i < _device_count; i++) {
+        PCA9622Model *device = _devices[i];
+        if (address != (device->address >> 1)) continue;
+        device->reads++;
+        while (_rx_length < quantity) {
+            _rx[_rx_length++] = device->read();
+        }
+        return quantity;
+    }
+    nacks++;
+    return 0;
+}
+
+uint8_t TwoWire::requestFrom(int address, int quantity) {
+    return requestFrom((uint8_t)address, (uint8_t)quantity);
+}
+
+size_t TwoWire::write(uint8_t data) {
+    if (_tx_length >= sizeof(_tx)) return 0;
+    _tx[_tx_length++] = data;
+    return 1;
+}
+
+size_t TwoWire::write(const uint8_t *buffer, size_t size) {
+    size_t written = 0;
+    while (size-- && write(*buffer++)) written++;
+    return written;
+}
+
+int TwoWire::available() {
+    return _rx_length - _rx_position;
+}
+
+int TwoWire::read() {
+    if (_rx_position >= _rx_length) return -1;
+    return _rx[_rx_position++];
+}
+
+bool TwoWire::attach(PCA9622Model *device) {
+    if (_device_count >= MOCK_BUS_MAX_DEVICES) return false;
+    _devices[_device_count++] = device;
+    return true;
+}
+
+void TwoWire::detachAll() {
+    _device_count = 0;
+    timed = false;
+    resetCounters();
+}
+
+/**
+ * @brief Counts the bytes of a transaction and lets them take bus time when the bus is timed
+ * 
+ */
+void TwoWire::transfer(uint32_t count) {
+    bytes += count;
+    if (timed) mock_advance((count * 9 * 1000000) / clock);
+}
+
+void TwoWire::resetCounters() {
+    transactions = 0;
+    bytes = 0;
+    nacks = 0;
+}
@@ -0,0 +1,62 @@
+/**
+ * @file Wire.h
+ * @brief Host mock of the Arduino Wire library. Every bus holds a set of simulated PCA9622 devices, see PCA9622Model.h
+ * 
+ */
+
+#ifndef __MOCK_WIRE_H
+#define __MOCK_WIRE_H
+
+#include "Arduino.h"
+
+#define MOCK_BUS_MAX_DEVICES 16
+
+class PCA9622Model;
+
+class TwoWire : public Stream
+{
+public:
+    void begin();
+    void setClock(uint32_t clock);
+
+    void beginTransmission(uint8_t address);
+    uint8_t endTransmission(bool sendStop = true);
+    uint8_t requestFrom(uint8_t address, uint8_t quantity);
+    uint8_t requestFrom(int address, int quantity);
+
+    size_t write(uint8_t data) override;
+    size_t write(const uint8_t *buffer, size_t size) override;
+    int available() override;
+    int read() override;
+
+    /**
+     * Mock control
+     */
+    bool attach(PCA9622Model *device);
+    void detachAll();
+    void resetCounters();
+
+    uint32_t clock = 100000;
+    uint32_t transactions = 0; // Write and read transactions
+    uint32_t bytes = 0; // Bytes on the bus including the address bytes
+    uint32_t nacks = 0;
+    bool timed = false; // Every byte advances the time by 9 clock cycles, so transfers take bus time
+
+private:
+    PCA9622Model *_devices[MOCK_BUS_MAX_DEVICES];
+    uint8_t _device_count = 0;
+
+    uint8_t _address = 0;
+    uint8_t _tx[256];
+    size_t _tx_length = 0;
+    uint8_t _rx[256];
+    size_t _rx_length = 0;
+    size_t _rx_position = 0;
+
+    void transfer(uint32_t count);
+};
+
+extern TwoWire Wire;
+extern TwoWire Wire1;
+
+#endif
@@ -0,0 +1,47 @@
+/**
+ * @file size_pca9622.cpp
+ * @brief Reference sketch for the memory usage in the README: a single RGB device and an array of 4 devices with a framebuffer.
+ * Only uses functions that exist in both modes. Built by make size, which sums the flash and RAM of the library symbols in the linked program
+ * 
+ */
+#include "PCA9622.h"
+#include "PCA9622Array.h"
+#include <stdio.h>
+
+#define DEVICE_COUNT 4
+
+PCA9622 device(0x10);
+PCA9622 devices[DEVICE_COUNT] = {PCA9622(0x12), PCA9622(0x14), PCA9622(0x16), PCA9622(0x18)};
+uint8_t framebuffer[DEVICE_COUNT * PCA9622_OUTPUT_COUNT];
+PCA9622Array fixture(devices, DEVICE_COUNT, framebuffer);
+
+void setup() {
+    device.begin();
+    device.setLEDColor(0, 255, 0, 0);
+    device.setAllLEDColor(0, 0, 255);
+    device.setLEDColorHSV(1, 85, 255, 255);
+    device.setGroupFrequency(500);
+    device.sleep();
+    device.wakeUp();
+
+    fixture.begin();
+    fixture.setChannelCurrent(20);
+    fixture.setCurrentBudget(400);
+}
+
+void loop() {
+    for (uint8_t d = 0; d < DEVICE_COUNT; d++) {
+        for (uint8_t output = 0; output < PCA9622_OUTPUT_COUNT; output++) {
+            fixture.setPWM(d, output, 255);
+            fixture.flush();
+            fixture.update();
+        }
+    }
+}
+
+int main() {
+    setup();
+    loop();
+    printf("sizeof(PCA9622) %u, sizeof(PCA9622Array) %u on this host\n", (unsigned)sizeof(PCA9622), (unsigned)sizeof(PCA9622Array));
+    return 0;
+}
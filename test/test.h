@@ -0,0 +1,34 @@
+/**
+ * @file test.h
+ * @brief Minimal test framework for the host tests. Tests register themselves with TEST and are run by test_main.cpp
+ * 
+ */
+
+#ifndef __TEST_H
+#define __TEST_H
+
+#include <stdio.h>
+#include <stdint.h>
+
+typedef void (*TestFunction)();
+
+struct TestCase {
+    TestCase(const char *name, TestFunction function);
+    const char *name;
+    TestFunction function;
+    TestCase *next;
+};
+
+extern uint32_t test_failures;
+bool test_check(bool passed, const char *file, int line, const char *expression);
+bool test_check_equal(long long actual, long long expected, const char *file, int line, const char *expression);
+
+#define TEST(name) \
+    static void test_##name(); \
+    static TestCase test_case_##name(#name, test_##name); \
+    static void test_##name()
+
+#define CHECK(expression) test_check((expression), __FILE__, __LINE__, #expression)
+#define CHECK_EQ(actual, expected) test_check_equal((long long)(actual), (long long)(expected), __FILE__, __LINE__, #actual " == " #expected)
+
+#endif
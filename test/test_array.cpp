@@ -0,0 +1,394 @@
+/**
+ * @file test_array.cpp
+ * @brief Host tests of PCA9622Array against the register model
+ * 
+ */
+#include "test.h"
+#include "PCA9622Array.h"
+#include "PCA9622Model.h"
+
+/*----------------------- Buses ----------------------------------------------*/
+
+TEST(array_leaves_out_devices_on_a_bus_that_does_not_fit) {
+    TwoWire buses[PCA9622_ARRAY_MAX_BUSES + 1];
+    PCA9622 devices[PCA9622_ARRAY_MAX_BUSES + 2];
+    uint8_t framebuffer[(PCA9622_ARRAY_MAX_BUSES + 2) * PCA9622_OUTPUT_COUNT] = {0};
+    for (uint8_t d = 0; d <= PCA9622_ARRAY_MAX_BUSES; d++) {
+        devices[d].setI2CAddress(0xA2);
+        devices[d].setBus(&buses[d]);
+    }
+    devices[PCA9622_ARRAY_MAX_BUSES + 1].setBus(&buses[0]);
+
+    PCA9622Array array(devices, PCA9622_ARRAY_MAX_BUSES + 2, framebuffer);
+    CHECK_EQ(array.getDeviceCount(), PCA9622_ARRAY_MAX_BUSES);
+    CHECK_EQ(array.getBusCount(), PCA9622_ARRAY_MAX_BUSES);
+    CHECK(!array.begin());
+    // The device that did not fit keeps its own bus
+    CHECK(devices[PCA9622_ARRAY_MAX_BUSES].getBus() == &buses[PCA9622_ARRAY_MAX_BUSES]);
+    CHECK(!array.setDeviceBus(0, &buses[PCA9622_ARRAY_MAX_BUSES]));
+    CHECK(devices[0].getBus() == &buses[0]);
+}
+
+TEST(array_begin_fails_when_devices_exceed_the_maximum) {
+    PCA9622Model model(0xA2);
+    Wire.attach(&model);
+    PCA9622 devices[PCA9622_ARRAY_MAX_DEVICES + 1];
+    uint8_t framebuffer[(PCA9622_ARRAY_MAX_DEVICES + 1) * PCA9622_OUTPUT_COUNT] = {0};
+    for (uint8_t d = 0; d <= PCA9622_ARRAY_MAX_DEVICES; d++) devices[d].setI2CAddress(0xA2);
+
+    PCA9622Array all(devices, PCA9622_ARRAY_MAX_DEVICES, framebuffer);
+    CHECK(all.begin());
+    PCA9622Array tooMany(devices, PCA9622_ARRAY_MAX_DEVICES + 1, framebuffer);
+    CHECK_EQ(tooMany.getDeviceCount(), PCA9622_ARRAY_MAX_DEVICES);
+    CHECK(!tooMany.begin());
+    CHECK(!model.isAsleep());
+}
+
+TEST(array_flushes_every_bus) {
+    PCA9622Model first(0xA2);
+    PCA9622Model second(0xA2);
+    Wire.attach(&first);
+    Wire1.attach(&second);
+    PCA9622 devices[2] = {PCA9622(0xA2), PCA9622(0xA2)};
+    devices[1].setBus(&Wire1);
+    uint8_t framebuffer[2 * PCA9622_OUTPUT_COUNT] = {0};
+
+    PCA9622Array array(devices, 2, framebuffer);
+    CHECK_EQ(array.getDeviceCount(), PCA9622_ARRAY_MAX_BUSES > 1 ? 2 : 1);
+    CHECK_EQ(array.begin(), PCA9622_ARRAY_MAX_BUSES > 1);
+    array.setPWM(0, 3, 0x30);
+    array.setPWM(1, 4, 0x40);
+    CHECK_EQ(array.flush(), 0);
+    CHECK_EQ(first.registers[PCA9622_PWM0 + 3], 0x30);
+    if (PCA9622_ARRAY_MAX_BUSES > 1) {
+        CHECK_EQ(second.registers[PCA9622_PWM0 + 4], 0x40);
+        CHECK_EQ(second.registers[PCA9622_PWM0 + 3], 0x00);
+    } else {
+        CHECK_EQ(second.writes, 0);
+    }
+}
+
+
+/*----------------------- Broadcast ------------------------------------------*/
+
+#ifndef PCA9622_LOW_FOOTPRINT
+TEST(fill_broadcast_keeps_auto_sleep_in_line_with_the_outputs) {
+    PCA9622Model first(0xA2);
+    PCA9622Model second(0xA4);
+    Wire.attach(&first);
+    Wire.attach(&second);
+    PCA9622 devices[2] = {PCA9622(0xA2), PCA9622(0xA4)};
+    uint8_t framebuffer[2 * PCA9622_OUTPUT_COUNT] = {0};
+    PCA9622Array array(devices, 2, framebuffer);
+    array.begin();
+    devices[0].setAutoSleep(100);
+    devices[1].setAutoSleep(100);
+
+    // A lit device is not put to sleep
+    CHECK_EQ(array.fillBroadcast(200), 0);
+    CHECK(!devices[0].isIdle() && !devices[1].isIdle());
+    mock_advance(150000);
+    devices[0].update();
+    devices[1].update();
+    CHECK(!first.isAsleep() && !second.isAsleep());
+    CHECK_EQ(first.duty(0), 200);
+    CHECK_EQ(second.duty(15), 200);
+
+    // A dark device is, and the next fill wakes it up before the outputs are written
+    CHECK_EQ(array.fillBroadcast(0), 0);
+    mock_advance(150000);
+    devices[0].update();
+    devices[1].update();
+    CHECK(first.isAsleep() && second.isAsleep());
+    CHECK_EQ(devices[0].getSleepCount(), 1);
+    CHECK_EQ(array.fillBroadcast(50), 0);
+    CHECK(!first.isAsleep() && !second.isAsleep());
+    CHECK(!devices[0].isAsleep() && !devices[1].isAsleep());
+    CHECK_EQ(first.duty(7), 50);
+    mock_advance(150000);
+    devices[0].update();
+    CHECK(!first.isAsleep());
+}
+#endif
+
+
+/*----------------------- Group blinking -------------------------------------*/
+
+TEST(blink_resync_restarts_the_oscillators_without_waiting) {
+    PCA9622Model first(0xA2);
+    PCA9622Model second(0xA4);
+    Wire.attach(&first);
+    Wire.attach(&second);
+    PCA9622 devices[2] = {PCA9622(0xA2), PCA9622(0xA4)};
+    uint8_t framebuffer[2 * PCA9622_OUTPUT_COUNT] = {0};
+    PCA9622Array array(devices, 2, framebuffer);
+    array.begin();
+
+    unsigned long delayed = mock_delayed();
+    array.setGroupBlinking(1000, 0x80);
+    CHECK_EQ(mock_delayed(), delayed);
+    CHECK_EQ(first.wakeUps, 2);
+    CHECK_EQ(second.wakeUps, 2);
+    CHECK(!first.isAsleep() && !second.isAsleep());
+    CHECK_EQ(first.registers[PCA9622_GRPFREQ], 23);
+
+    // The periodic resync from update does not block the loop either
+    array.setBlinkResyncInterval(100);
+    mock_advance(100000);
+    array.update();
+    CHECK_EQ(mock_delayed(), delayed);
+    CHECK_EQ(first.wakeUps, 3);
+    CHECK_EQ(second.wakeUps, 3);
+}
+
+
+/*----------------------- Current budget ------------------------------------*/
+
+TEST(current_estimate_follows_the_framebuffer_sum) {
+    PCA9622 devices[2] = {PCA9622(0xA2), PCA9622(0xA4)};
+    uint8_t framebuffer[2 * PCA9622_OUTPUT_COUNT];
+    for (uint8_t i = 0; i < sizeof(framebuffer); i++) framebuffer[i] = 100;
+
+    // The constructor sums the content of the framebuffer: 3200 * 20 mA / 256
+    PCA9622Array array(devices, 2, framebuffer);
+    array.setChannelCurrent(20);
+    CHECK_EQ(array.getEstimatedCurrent(), 250);
+
+    // Direct writes are only counted after invalidate
+    framebuffer[0] = 0;
+    CHECK_EQ(array.getEstimatedCurrent(), 250);
+    array.invalidate();
+    CHECK_EQ(array.getEstimatedCurrent(), 242);
+    array.setPWM(0, 1, 0);
+    CHECK_EQ(array.getEstimatedCurrent(), 234);
+    array.setPWM(0, 1, 100);
+    CHECK_EQ(array.getEstimatedCurrent(), 242);
+}
+
+TEST(current_budget_scales_the_flushed_values_only) {
+    PCA9622Model first(0xA2);
+    PCA9622Model second(0xA4);
+    Wire.attach(&first);
+    Wire.attach(&second);
+    PCA9622 devices[2] = {PCA9622(0xA2), PCA9622(0xA4)};
+    uint8_t framebuffer[2 * PCA9622_OUTPUT_COUNT] = {0};
+    PCA9622Array array(devices, 2, framebuffer);
+    array.begin();
+    array.setChannelCurrent(20);
+    array.fill(255);
+
+    // 32 outputs * 20 mA, rounded down by the fixed point steps
+    CHECK_EQ(array.getEstimatedCurrent(), 637);
+    CHECK_EQ(array.getCurrentScale(), PCA9622_SCALE_NONE);
+    array.setGroupPWM(127);
+    CHECK_EQ(array.getEstimatedCurrent(), 318);
+    array.setGroupPWM(0xFF);
+
+    // 400 / 637 in 8.8 fixed point
+    array.setCurrentBudget(400);
+    CHECK_EQ(array.getCurrentScale(), 160);
+    CHECK_EQ(array.flush(), 0);
+    for (uint8_t i = 0; i < PCA9622_OUTPUT_COUNT; i++) {
+        CHECK_EQ(first.registers[PCA9622_PWM0 + i], 159);
+        CHECK_EQ(second.registers[PCA9622_PWM0 + i], 159);
+        CHECK_EQ(array.getPWM(0, i), 255);
+        CHECK_EQ(framebuffer[PCA9622_OUTPUT_COUNT + i], 255);
+    }
+
+    // Within the budget the values are written unscaled again
+    array.setCurrentBudget(1000);
+    CHECK_EQ(array.getCurrentScale(), PCA9622_SCALE_NONE);
+    CHECK_EQ(array.flush(), 0);
+    CHECK_EQ(first.registers[PCA9622_PWM0], 255);
+    CHECK_EQ(second.registers[PCA9622_PWM0 + 15], 255);
+}
+
+#ifndef PCA9622_LOW_FOOTPRINT
+TEST(current_budget_counts_outputs_that_are_fully_on) {
+    PCA9622Model first(0xA2);
+    PCA9622Model second(0xA4);
+    Wire.attach(&first);
+    Wire.attach(&second);
+    PCA9622 devices[2] = {PCA9622(0xA2), PCA9622(0xA4)};
+    uint8_t framebuffer[2 * PCA9622_OUTPUT_COUNT] = {0};
+    PCA9622Array array(devices, 2, framebuffer);
+    array.begin();
+    array.setChannelCurrent(20);
+    for (uint8_t output = 0; output < 4; output++) devices[0].setPWMOutputState(output, LED_State::ON);
+
+    // The outputs that are on draw the channel current whatever their PWM value
+    CHECK_EQ(array.getEstimatedCurrent(), 80);
+    array.fill(255);
+    CHECK_EQ(array.getEstimatedCurrent(), 80 + 557);
+
+    // The other outputs share the rest of the budget: 320 / 557
+    array.setCurrentBudget(400);
+    CHECK_EQ(array.getCurrentScale(), 147);
+    CHECK_EQ(array.flush(), 0);
+    CHECK_EQ(first.registers[PCA9622_PWM0 + 4], 146);
+    CHECK_EQ(second.registers[PCA9622_PWM0], 146);
+
+    // Nothing is left when the outputs that are on exceed the budget by themselves
+    array.setCurrentBudget(60);
+    CHECK_EQ(array.getCurrentScale(), 0);
+    CHECK_EQ(array.flush(), 0);
+    CHECK_EQ(first.registers[PCA9622_PWM0 + 4], 0);
+    CHECK_EQ(second.registers[PCA9622_PWM0 + 15], 0);
+}
+#endif
+
+
+/*----------------------- Verification --------------------------------------*/
+
+#ifndef PCA9622_LOW_FOOTPRINT
+TEST(verification_puts_a_device_that_should_sleep_back_to_sleep) {
+    PCA9622Model model(0xA2);
+    Wire.attach(&model);
+    PCA9622 devices[1] = {PCA9622(0xA2)};
+    uint8_t framebuffer[PCA9622_OUTPUT_COUNT] = {0};
+    PCA9622Array array(devices, 1, framebuffer);
+    array.begin();
+    array.flush();
+    devices[0].sleep();
+    CHECK(model.isAsleep());
+
+    // A glitch wakes the device up
+    model.registers[PCA9622_MODE1] &= ~0x10;
+    CHECK_EQ(array.verifyNext(), 0);
+    CHECK_EQ(array.getRepairCount(), 1);
+    CHECK(model.isAsleep());
+    CHECK(devices[0].isAsleep());
+    for (uint8_t i = 0; i < 4; i++) array.verifyNext();
+    CHECK_EQ(array.getRepairCount(), 1);
+}
+
+TEST(verification_reads_mode1_on_its_own_and_short_windows) {
+    PCA9622Model first(0xA2);
+    PCA9622Model second(0xA4);
+    Wire.attach(&first);
+    Wire.attach(&second);
+    PCA9622 devices[2] = {PCA9622(0xA2), PCA9622(0xA4)};
+    uint8_t framebuffer[2 * PCA9622_OUTPUT_COUNT] = {0};
+    PCA9622Array array(devices, 2, framebuffer);
+    array.begin();
+    array.flush();
+    array.setVerification(100, 4);
+
+    // MODE1 of every device, then the windows of 4 registers
+    Wire.resetCounters();
+    CHECK_EQ(array.verifyNext(), 0);
+    CHECK_EQ(Wire.bytes, 4);
+    CHECK_EQ(array.verifyNext(), 0);
+    CHECK_EQ(Wire.bytes, 8);
+    CHECK_EQ(array.verifyNext(), 0);
+    CHECK_EQ(Wire.bytes, 15);
+
+    // A rotation is MODE1, 6 windows over PWM0..LEDOUT3 and MODE1 again
+    for (uint8_t i = 0; i < 11; i++) CHECK_EQ(array.verifyNext(), 0);
+    CHECK_EQ(Wire.bytes, 2 * (4 + (5 * 7) + 5));
+    CHECK_EQ(array.verifyNext(), 0);
+    CHECK_EQ(Wire.bytes, 2 * (4 + (5 * 7) + 5) + 4);
+    CHECK_EQ(array.getRepairCount(), 0);
+}
+
+TEST(verification_keeps_the_group_pwm_of_every_device) {
+    PCA9622Model first(0xA2);
+    PCA9622Model second(0xA4);
+    Wire.attach(&first);
+    Wire.attach(&second);
+    PCA9622 devices[2] = {PCA9622(0xA2), PCA9622(0xA4)};
+    uint8_t framebuffer[2 * PCA9622_OUTPUT_COUNT] = {0};
+    PCA9622Array array(devices, 2, framebuffer);
+    array.begin();
+    array.flush();
+    array.setVerification(100, 22);
+    devices[1].setGroupPWM(0x40);
+    for (uint8_t i = 0; i < 4; i++) CHECK_EQ(array.verifyNext(), 0);
+    CHECK_EQ(second.registers[PCA9622_GRPPWM], 0x40);
+    CHECK_EQ(array.getRepairCount(), 0);
+
+    // A glitch is repaired to the value of the device itself
+    first.registers[PCA9622_GRPPWM] = 0x10;
+    second.registers[PCA9622_GRPPWM] = 0x10;
+    for (uint8_t i = 0; i < 4; i++) CHECK_EQ(array.verifyNext(), 0);
+    CHECK_EQ(first.registers[PCA9622_GRPPWM], 0xFF);
+    CHECK_EQ(second.registers[PCA9622_GRPPWM], 0x40);
+    CHECK_EQ(array.getRepairCount(), 2);
+
+    // The duty cycle of a broadcast is tracked as well
+    array.setGroupBlinking(1000, 0x80);
+    for (uint8_t i = 0; i < 4; i++) CHECK_EQ(array.verifyNext(), 0);
+    CHECK_EQ(first.registers[PCA9622_GRPPWM], 0x80);
+    CHECK_EQ(array.getRepairCount(), 2);
+}
+
+TEST(verification_budget_is_a_share_of_the_bus_time) {
+    PCA9622Model model(0xA2);
+    Wire.attach(&model);
+    Wire.timed = true;
+    PCA9622 devices[1] = {PCA9622(0xA2)};
+    uint8_t framebuffer[PCA9622_OUTPUT_COUNT] = {0};
+    PCA9622Array array(devices, 1, framebuffer);
+    array.begin();
+    array.flush();
+    // 18 bytes of 9 clock cycles at 100 kHz
+    CHECK_EQ(array.getBusFrameTime(0), 1620);
+
+    // The MODE1 step moves 4 bytes, 360 us of bus time is 10% of 3600 us
+    array.setVerification(10);
+    Wire.resetCounters();
+    array.update();
+    CHECK_EQ(Wire.bytes, 4);
+    mock_advance(3600 - 360 - 1);
+    array.update();
+    CHECK_EQ(Wire.bytes, 4);
+    mock_advance(1);
+    array.update();
+    CHECK_EQ(Wire.bytes, 4 + 11);
+}
+
+TEST(blink_resync_updates_the_sleep_shadow) {
+    PCA9622Model first(0xA2);
+    PCA9622Model second(0xA4);
+    Wire.attach(&first);
+    Wire.attach(&second);
+    PCA9622 devices[2] = {PCA9622(0xA2), PCA9622(0xA4)};
+    uint8_t framebuffer[2 * PCA9622_OUTPUT_COUNT] = {0};
+    PCA9622Array array(devices, 2, framebuffer);
+    array.begin();
+    array.flush();
+    devices[1].sleep();
+
+    // The resync wakes up every device on the bus through the AllCall address
+    array.resyncGroupBlinking();
+    CHECK(!second.isAsleep());
+    CHECK(!devices[1].isAsleep());
+    for (uint8_t i = 0; i < 8; i++) CHECK_EQ(array.verifyNext(), 0);
+    CHECK_EQ(array.getRepairCount(), 0);
+}
+#endif
+
+
+/*----------------------- Asynchronous initialization ------------------------*/
+
+#ifndef PCA9622_LOW_FOOTPRINT
+TEST(array_begin_async_fails_while_a_device_is_busy) {
+    PCA9622Model first(0xA2);
+    PCA9622Model second(0xA4);
+    Wire.attach(&first);
+    Wire.attach(&second);
+    PCA9622 devices[2] = {PCA9622(0xA2), PCA9622(0xA4)};
+    uint8_t framebuffer[2 * PCA9622_OUTPUT_COUNT] = {0};
+    PCA9622Array array(devices, 2, framebuffer);
+
+    CHECK(devices[1].softwareResetAsync());
+    CHECK(!array.beginAsync());
+    CHECK(!devices[0].isBusy());
+    while (array.poll(micros())) mock_advance(10);
+
+    CHECK(array.beginAsync());
+    CHECK(!array.wakeUpAsync());
+    while (array.poll(micros())) mock_advance(10);
+    CHECK(!first.isAsleep() && !second.isAsleep());
+}
+#endif
@@ -0,0 +1,181 @@
+/**
+ * @file test_effects.cpp
+ * @brief Host tests of the effects renderer
+ * 
+ */
+#include "test.h"
+#include "PCA9622Effects.h"
+#include "PCA9622Model.h"
+
+/**
+ * @brief A single color on all its pixels
+ * 
+ */
+class SolidEffect : public PCA9622Effect
+{
+public:
+    SolidEffect(uint16_t pixelCount) : PCA9622Effect(0, pixelCount) {}
+    void update(PCA9622Effects &effects, uint32_t now) override { (void)effects; (void)now; }
+    void render(uint16_t pixel, uint8_t *rgb) override {
+        (void)pixel;
+        rgb[0] = 0x10;
+        rgb[1] = 0x20;
+        rgb[2] = 0x30;
+    }
+};
+
+/**
+ * @brief A color per pixel that can be changed from the test. Counts the rendered pixels
+ * 
+ */
+class PixelEffect : public PCA9622Effect
+{
+public:
+    PixelEffect(uint16_t pixelCount, uint8_t red, uint8_t green, uint8_t blue) : PCA9622Effect(0, pixelCount) {
+        for (uint16_t pixel = 0; pixel < pixelCount && pixel < 16; pixel++) {
+            colors[pixel][0] = red;
+            colors[pixel][1] = green;
+            colors[pixel][2] = blue;
+        }
+    }
+    void update(PCA9622Effects &effects, uint32_t now) override { (void)effects; (void)now; }
+    void render(uint16_t pixel, uint8_t *rgb) override {
+        renders++;
+        memcpy(rgb, colors[pixel], 3);
+    }
+
+    uint8_t colors[16][3];
+    uint16_t renders = 0;
+};
+
+/**
+ * @brief Blends a top color over a bottom color on a single RGB pixel and returns the result in the framebuffer
+ * 
+ */
+static void blendPixel(EBlendMode blendMode, uint8_t alpha, uint8_t *result) {
+    PCA9622 devices[1];
+    uint8_t framebuffer[PCA9622_OUTPUT_COUNT] = {0};
+    PCA9622Array array(devices, 1, framebuffer);
+    PCA9622Effects effects(array, 3);
+    PixelEffect bottom(1, 200, 100, 0);
+    PixelEffect top(1, 100, 100, 10);
+    effects.addEffect(bottom);
+    effects.addEffect(top, blendMode, alpha);
+    effects.update(0);
+    for (uint8_t i = 0; i < 3; i++) result[i] = array.getPWM(0, i);
+}
+
+TEST(effects_blend_the_layers) {
+    uint8_t rgb[3];
+    // Add clips every channel at 255
+    blendPixel(EBlendMode::Add, 255, rgb);
+    CHECK_EQ(rgb[0], 255);
+    CHECK_EQ(rgb[1], 200);
+    CHECK_EQ(rgb[2], 10);
+
+    blendPixel(EBlendMode::Max, 255, rgb);
+    CHECK_EQ(rgb[0], 200);
+    CHECK_EQ(rgb[1], 100);
+    CHECK_EQ(rgb[2], 10);
+
+    // Alpha 128 weighs the top layer 129 / 256
+    blendPixel(EBlendMode::Alpha, 128, rgb);
+    CHECK_EQ(rgb[0], 149);
+    CHECK_EQ(rgb[1], 100);
+    CHECK_EQ(rgb[2], 5);
+    blendPixel(EBlendMode::Alpha, 255, rgb);
+    CHECK_EQ(rgb[0], 100);
+    CHECK_EQ(rgb[1], 100);
+    CHECK_EQ(rgb[2], 10);
+    blendPixel(EBlendMode::Alpha, 0, rgb);
+    CHECK_EQ(rgb[0], 200);
+    CHECK_EQ(rgb[1], 100);
+    CHECK_EQ(rgb[2], 0);
+}
+
+TEST(effects_render_and_flush_only_the_changed_pixels) {
+    PCA9622Model model(0xA2);
+    Wire.attach(&model);
+    PCA9622 devices[1] = {PCA9622(0xA2)};
+    uint8_t framebuffer[PCA9622_OUTPUT_COUNT] = {0};
+    PCA9622Array array(devices, 1, framebuffer);
+    array.begin();
+    PCA9622Effects effects(array);
+    PixelEffect pixels(16, 0x40, 0, 0);
+    effects.addEffect(pixels);
+    CHECK_EQ(effects.update(0), 16);
+    CHECK_EQ(array.flush(), 0);
+    CHECK_EQ(array.getBusFrameBytes(0), 16 + 2);
+
+    // Nothing changed, nothing is rendered or written
+    pixels.renders = 0;
+    CHECK_EQ(effects.update(1), 0);
+    CHECK_EQ(pixels.renders, 0);
+    CHECK_EQ(array.flush(), 0);
+    CHECK_EQ(array.getBusFrameBytes(0), 0);
+
+    // A pixel that is not invalidated is not rendered again, even when the framebuffer differs
+    pixels.colors[5][0] = 0x80;
+    framebuffer[6] = 0x99;
+    effects.invalidate(5);
+    Wire.resetCounters();
+    CHECK_EQ(effects.update(2), 1);
+    CHECK_EQ(pixels.renders, 1);
+    CHECK_EQ(array.getPWM(0, 5), 0x80);
+    CHECK_EQ(array.getPWM(0, 6), 0x99);
+
+    // The flush writes the single output in a single transaction
+    CHECK_EQ(array.flush(), 0);
+    CHECK_EQ(array.getBusFrameBytes(0), 1 + 2);
+    CHECK_EQ(Wire.transactions, 1);
+    CHECK_EQ(model.registers[PCA9622_PWM0 + 5], 0x80);
+    CHECK_EQ(model.registers[PCA9622_PWM0 + 6], 0x40);
+}
+
+TEST(effects_use_the_led_configuration_of_the_device) {
+    PCA9622 devices[2];
+    devices[0].setLEDConfiguration(LED_Configuration::GRBA);
+    devices[1].setLEDConfiguration(LED_Configuration::ARGB);
+    uint8_t framebuffer[2 * PCA9622_OUTPUT_COUNT];
+    memset(framebuffer, 0xEE, sizeof(framebuffer));
+    PCA9622Array array(devices, 2, framebuffer);
+    PCA9622Effects effects(array, 4);
+    SolidEffect solid(8);
+    effects.addEffect(solid);
+    effects.update(0);
+
+    const uint8_t grba[4] = {0x20, 0x10, 0x30, 0x00};
+    const uint8_t argb[4] = {0x00, 0x10, 0x20, 0x30};
+    for (uint8_t output = 0; output < PCA9622_OUTPUT_COUNT; output++) {
+        CHECK_EQ(array.getPWM(0, output), grba[output % 4]);
+        CHECK_EQ(array.getPWM(1, output), argb[output % 4]);
+    }
+}
+
+TEST(effects_pack_plain_rgb_when_the_led_configuration_does_not_match) {
+    PCA9622 devices[2];
+    devices[0].setLEDConfiguration(LED_Configuration::GRB); // 3 channels on 4 channel pixels
+    devices[1].setLEDConfiguration(LED_Configuration::GRBA);
+    uint8_t framebuffer[2 * PCA9622_OUTPUT_COUNT];
+    memset(framebuffer, 0xEE, sizeof(framebuffer));
+    PCA9622Array array(devices, 2, framebuffer);
+
+    PCA9622Effects rgba(array, 4);
+    SolidEffect solid(4);
+    rgba.addEffect(solid);
+    rgba.update(0);
+    for (uint8_t output = 0; output < PCA9622_OUTPUT_COUNT; output++) {
+        const uint8_t plain[4] = {0x10, 0x20, 0x30, 0x00};
+        CHECK_EQ(array.getPWM(0, output), plain[output % 4]);
+    }
+    rgba.removeEffect(solid);
+
+    PCA9622Effects rgb(array, 3);
+    SolidEffect second(10);
+    rgb.addEffect(second);
+    rgb.update(0);
+    for (uint8_t output = 0; output < 15; output++) {
+        const uint8_t plain[3] = {0x10, 0x20, 0x30};
+        CHECK_EQ(array.getPWM(1, output), plain[output % 3]);
+    }
+}
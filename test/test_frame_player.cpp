@@ -0,0 +1,67 @@
+/**
+ * @file test_frame_player.cpp
+ * @brief Host tests of the frame player with the show of the FramePlayback example
+ * 
+ */
+#include "test.h"
+#include "PCA9622FramePlayer.h"
+#include "PCA9622Model.h"
+#include "../examples/02. Advanced/FramePlayback/show.h"
+#include <stdlib.h>
+
+TEST(frame_player_counts_frame_periods) {
+    PCA9622Model first(0xA2);
+    PCA9622Model second(0xA4);
+    Wire.attach(&first);
+    Wire.attach(&second);
+    PCA9622 devices[2] = {PCA9622(0xA2), PCA9622(0xA4)};
+    PCA9622FramePlayer player(devices, 2);
+    CHECK_EQ(player.begin(show), 0);
+    CHECK_EQ(player.getShowDeviceCount(), 2);
+
+    uint32_t periods = 0;
+    uint8_t hold;
+    while ((hold = player.nextFrame()) > 0) {
+        periods += hold;
+        CHECK_EQ(player.getFrame(), periods);
+    }
+    CHECK_EQ(player.getFrame(), SHOW_FRAMES);
+    CHECK_EQ(player.getError(), 0);
+    CHECK(!player.isPlaying());
+    // The show ends with all outputs breathing at the same level
+    for (uint8_t output = 1; output < 16; output++) {
+        CHECK_EQ(second.registers[PCA9622_PWM0 + output], first.registers[PCA9622_PWM0]);
+    }
+}
+
+TEST(frame_player_stops_at_the_show_length) {
+    // A copy of the show of exactly the given length without the end command, ASan reports any read past it
+    for (uint32_t length = PCA9622_FRAME_HEADER_SIZE; length < sizeof(show); length += 7) {
+        uint8_t *cut = (uint8_t *)malloc(length);
+        memcpy(cut, show, length);
+        for (uint8_t i = 0; i < 4; i++) cut[6 + i] = length >> (i * 8);
+
+        PCA9622FramePlayer decoder(nullptr, 0);
+        CHECK_EQ(decoder.begin(cut, false), 0);
+        while (decoder.nextFrame() > 0);
+        CHECK(!decoder.isPlaying());
+        CHECK(decoder.getFrame() <= SHOW_FRAMES);
+        free(cut);
+    }
+}
+
+TEST(frame_player_rejects_invalid_headers) {
+    uint8_t header[PCA9622_FRAME_HEADER_SIZE];
+    memcpy(header, show, sizeof(header));
+    PCA9622FramePlayer decoder(nullptr, 0);
+    header[6] = PCA9622_FRAME_HEADER_SIZE - 1;
+    header[7] = 0;
+    CHECK_EQ(decoder.begin(header, false), 3);
+    CHECK(!decoder.isPlaying());
+    header[2] = 1;
+    CHECK_EQ(decoder.begin(header, false), 2);
+    header[0] = 'X';
+    CHECK_EQ(decoder.begin(header, false), 1);
+    decoder.rewind();
+    CHECK(!decoder.isPlaying());
+}
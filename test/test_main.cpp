@@ -0,0 +1,56 @@
+/**
+ * @file test_main.cpp
+ * @brief Runs all registered host tests, or the tests whose name contains the first argument
+ * 
+ */
+#include "test.h"
+#include "Arduino.h"
+#include <string.h>
+
+static TestCase *tests = nullptr;
+static TestCase *last = nullptr;
+uint32_t test_failures = 0;
+
+TestCase::TestCase(const char *testName, TestFunction testFunction) {
+    name = testName;
+    function = testFunction;
+    next = nullptr;
+    // Keep the order of the source files
+    if (last) last->next = this; else tests = this;
+    last = this;
+}
+
+bool test_check(bool passed, const char *file, int line, const char *expression) {
+    if (!passed) {
+        test_failures++;
+        printf("  %s:%d: CHECK(%s) failed\n", file, line, expression);
+    }
+    return passed;
+}
+
+bool test_check_equal(long long actual, long long expected, const char *file, int line, const char *expression) {
+    if (actual != expected) {
+        test_failures++;
+        printf("  %s:%d: CHECK_EQ(%s) failed: %lld != %lld\n", file, line, expression, actual, expected);
+        return false;
+    }
+    return true;
+}
+
+int main(int argc, char **argv) {
+    uint32_t count = 0;
+    uint32_t failed = 0;
+    for (TestCase *test = tests; test != nullptr; test = test->next) {
+        if (argc > 1 && strstr(test->name, argv[1]) == nullptr) continue;
+        mock_reset();
+        uint32_t before = test_failures;
+        test->function();
+        count++;
+        if (test_failures != before) {
+            failed++;
+            printf("FAIL %s\n", test->name);
+        }
+    }
+    printf("%u tests, %u failed\n", count, failed);
+    return failed ? 1 : 0;
+}
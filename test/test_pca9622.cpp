@@ -0,0 +1,596 @@
+/**
+ * @file test_pca9622.cpp
+ * @brief Host tests of the PCA9622 driver against the register model
+ * 
+ */
+#include "test.h"
+#include "PCA9622.h"
+#include "PCA9622Model.h"
+#include "I2C_coms.h"
+
+/**
+ * @brief A device under test and a second device on the same bus that should never be written
+ * 
+ */
+struct Fixture {
+    PCA9622Model model;
+    PCA9622Model other;
+    PCA9622 device;
+
+    Fixture() : model(0xA2), other(0xA4), device(0xA2) {
+        Wire.attach(&model);
+        Wire.attach(&other);
+    }
+};
+
+/**
+ * @brief Compares two register snapshots. The auto increment bits of MODE1 reflect the last control register and are ignored
+ * 
+ */
+static bool registersEqual(const uint8_t *a, const uint8_t *b) {
+    if ((a[PCA9622_MODE1] & 0x1F) != (b[PCA9622_MODE1] & 0x1F)) return false;
+    return memcmp(a + 1, b + 1, MODEL_REGISTER_COUNT - 1) == 0;
+}
+
+
+/*----------------------- Initialisation -------------------------------------*/
+
+TEST(begin_wakes_up_and_sets_pwm_and_group_control) {
+    Fixture f;
+    f.device.begin();
+    CHECK(!f.model.isAsleep());
+    for (uint8_t reg = PCA9622_LED_OUT0; reg <= PCA9622_LED_OUT3; reg++) {
+        CHECK_EQ(f.model.registers[reg], 0xFF);
+    }
+    CHECK(!f.device.isAsleep());
+    CHECK_EQ(f.other.writes, 0);
+}
+
+TEST(software_reset_restores_power_up_values) {
+    Fixture f;
+    f.device.begin();
+    f.device.setAllPWMOutputs(0x80);
+    f.device.softwareReset();
+    PCA9622Model powerUp(0xA2);
+    CHECK(registersEqual(f.model.registers, powerUp.registers));
+    CHECK(f.device.isAsleep());
+}
+
+TEST(probe_checks_read_only_bits) {
+    Fixture f;
+    CHECK(PCA9622::probe(0xA2));
+    CHECK(!PCA9622::probe(0xA6));
+}
+
+/**
+ * @brief Devices on both sides of the address range and one on a SubCall address that the scan skips
+ * 
+ */
+struct ScanFixture {
+    PCA9622Model low;
+    PCA9622Model middle;
+    PCA9622Model subCall;
+    PCA9622Model high;
+
+    ScanFixture(TwoWire *bus) : low(PCA9622_I2C_FIRST_ADDRESS), middle(0x40), subCall(PCA9622_I2C_SUB_1), high(PCA9622_I2C_LAST_ADDRESS) {
+        bus->attach(&low);
+        bus->attach(&middle);
+        bus->attach(&subCall);
+        bus->attach(&high);
+    }
+};
+
+TEST(scan_skips_the_broadcast_addresses) {
+    ScanFixture f(&Wire);
+    uint8_t addresses[8];
+    uint32_t duration = 1;
+    CHECK_EQ(PCA9622::scan(addresses, 8, &duration), 3);
+    CHECK_EQ(addresses[0], PCA9622_I2C_FIRST_ADDRESS);
+    CHECK_EQ(addresses[1], 0x40);
+    CHECK_EQ(addresses[2], PCA9622_I2C_LAST_ADDRESS);
+    CHECK_EQ(duration, 0);
+
+    // 112 addresses without the 4 broadcast addresses, every device found costs a read
+    CHECK_EQ(Wire.transactions, 108 + 3);
+    CHECK_EQ(Wire.nacks, 108 - 3);
+    CHECK_EQ(f.subCall.reads, 0);
+}
+
+TEST(scan_stops_when_the_buffer_is_full) {
+    ScanFixture f(&Wire);
+    uint8_t addresses[3] = {0, 0, 0xAA};
+    CHECK_EQ(PCA9622::scan(addresses, 2), 2);
+    CHECK_EQ(addresses[0], PCA9622_I2C_FIRST_ADDRESS);
+    CHECK_EQ(addresses[1], 0x40);
+    CHECK_EQ(addresses[2], 0xAA);
+    CHECK_EQ(f.high.reads, 0);
+    CHECK_EQ(PCA9622::scan(addresses, 0), 0);
+}
+
+TEST(scan_sets_the_bus_and_address_of_the_devices) {
+    ScanFixture f(&Wire1);
+    PCA9622 devices[4];
+    CHECK_EQ(PCA9622::scan(devices, 4, nullptr, &Wire1), 3);
+    CHECK(devices[0].getBus() == &Wire1);
+    CHECK_EQ(devices[0].getI2CAddress(), PCA9622_I2C_FIRST_ADDRESS);
+    CHECK(devices[2].getBus() == &Wire1);
+    CHECK_EQ(devices[2].getI2CAddress(), PCA9622_I2C_LAST_ADDRESS);
+    CHECK(devices[3].getBus() == &Wire);
+    CHECK_EQ(Wire.transactions, 0);
+
+    devices[2].begin();
+    CHECK(!f.high.isAsleep());
+}
+
+TEST(read_fails_when_the_device_does_not_answer) {
+    ScanFixture f(&Wire);
+    uint8_t data[2] = {0x11, 0x22};
+    CHECK_EQ(i2c_read_multi(&Wire, 0xA2, PCA9622_MODE1, data, 2), 2);
+    // The AllCall address acknowledges the register address but can not be read
+    CHECK_EQ(i2c_read_multi(&Wire, PCA9622_I2C_ALL_CALL, PCA9622_MODE1, data, 2), 4);
+    CHECK_EQ(data[0], 0x11);
+    CHECK(!PCA9622::probe(PCA9622_I2C_ALL_CALL));
+    CHECK_EQ(i2c_read_multi(&Wire, 0x40, PCA9622_MODE1 | PCA9622_AI_ALL, data, 2), 0);
+}
+
+
+/*----------------------- Edge cases -----------------------------------------*/
+
+TEST(group_frequency_rounds_to_closest_register_value) {
+    Fixture f;
+    f.device.begin();
+    for (uint32_t ms = 0; ms <= 0xFFFF; ms++) {
+        uint32_t clamped = ms < 42 ? 42 : (ms > 10666 ? 10666 : ms);
+        uint32_t expected = ((clamped * 24) + 500) / 1000 - 1; // round(ms * 24 / 1000) - 1
+        uint16_t period = f.device.setGroupFrequency(ms);
+        if (!CHECK_EQ(f.model.registers[PCA9622_GRPFREQ], expected)) break;
+        // The returned period is the period of the register value, at most half a step (1000 / 48 ms) from the request
+        if (!CHECK_EQ(period, ((expected + 1) * 1000 + 12) / 24)) break;
+        if (!CHECK((period > clamped ? period - clamped : clamped - period) <= 21)) break;
+    }
+}
+
+TEST(group_frequency_period_uses_32_bit_math) {
+    // (255 + 1) * 1000 overflows the 16-bit int of AVR
+    CHECK_EQ(PCA9622::groupFrequencyRegister(10666), 255);
+    CHECK_EQ(PCA9622::groupFrequencyPeriod(255), 10667);
+    CHECK_EQ(PCA9622::groupFrequencyPeriod(32), 1375);
+    CHECK_EQ(PCA9622::groupFrequencyRegister(42), 0);
+    CHECK_EQ(PCA9622::groupFrequencyPeriod(0), 42);
+    for (uint16_t reg = 0; reg <= 0xFF; reg++) {
+        CHECK_EQ(PCA9622::groupFrequencyRegister(PCA9622::groupFrequencyPeriod(reg)), reg);
+    }
+}
+
+TEST(output_state_clamps_ledout_index) {
+    Fixture f;
+    f.device.begin();
+    for (uint16_t led = 4; led <= 0xFF; led++) {
+        uint8_t before[MODEL_REGISTER_COUNT];
+        memcpy(before, f.model.registers, sizeof(before));
+        f.device.setOutputState(led, LED_State::ON);
+        CHECK_EQ(f.model.registers[PCA9622_LED_OUT3], 0x55);
+        // Only LEDOUT3 changes, the SubCall and AllCall addresses stay untouched
+        before[PCA9622_LED_OUT3] = 0x55;
+        CHECK(registersEqual(f.model.registers, before));
+        f.model.registers[PCA9622_LED_OUT3] = 0xFF;
+    }
+}
+
+TEST(pwm_output_above_15_is_ignored) {
+    Fixture f;
+    f.device.begin();
+    uint8_t before[MODEL_REGISTER_COUNT];
+    memcpy(before, f.model.registers, sizeof(before));
+    uint32_t transactions = Wire.transactions;
+    for (uint16_t output = 16; output <= 0xFF; output++) {
+        f.device.setPWMOutput(output, 0x77);
+    }
+    CHECK_EQ(Wire.transactions, transactions);
+    CHECK(registersEqual(f.model.registers, before));
+
+    f.device.setPWMOutput(15, 0x77);
+    CHECK_EQ(f.model.registers[PCA9622_PWM0 + 15], 0x77);
+    CHECK_EQ(f.model.registers[PCA9622_GRPPWM], before[PCA9622_GRPPWM]);
+}
+
+TEST(led_color_clamps_led_index) {
+    Fixture f;
+    f.device.begin();
+    uint8_t before[MODEL_REGISTER_COUNT];
+    memcpy(before, f.model.registers, sizeof(before));
+    for (uint16_t led = 5; led <= 0xFF; led++) {
+        f.device.setLEDColor(led, 1, 2, 3);
+    }
+    // RGB: LED 4 is output 12..14, output 15 and GRPPWM stay untouched
+    before[PCA9622_PWM0 + 12] = 1;
+    before[PCA9622_PWM0 + 13] = 2;
+    before[PCA9622_PWM0 + 14] = 3;
+    CHECK(registersEqual(f.model.registers, before));
+
+    f.device.setLEDConfiguration(LED_Configuration::RGBA);
+    for (uint16_t led = 4; led <= 0xFF; led++) {
+        f.device.setLEDColor(led, 4, 5, 6, 7);
+    }
+    // RGBA: LED 3 is output 12..15
+    before[PCA9622_PWM0 + 12] = 4;
+    before[PCA9622_PWM0 + 13] = 5;
+    before[PCA9622_PWM0 + 14] = 6;
+    before[PCA9622_PWM0 + 15] = 7;
+    CHECK(registersEqual(f.model.registers, before));
+}
+
+TEST(led_color_of_the_wrong_channel_count_turns_the_outputs_off) {
+    Fixture f;
+    f.device.begin();
+    f.device.setAllPWMOutputs(0x77);
+    f.device.setLEDConfiguration(LED_Configuration::RGBA);
+    f.device.setLEDColor(1, 1, 2, 3);
+    f.device.setLEDConfiguration(LED_Configuration::RGB);
+    f.device.setLEDColor(3, 1, 2, 3, 4);
+    for (uint8_t output = 0; output < 16; output++) {
+        bool off = (output >= 3 && output < 6) || (output >= 12);
+        CHECK_EQ(f.model.registers[PCA9622_PWM0 + output], off ? 0 : 0x77);
+    }
+}
+
+TEST(led_output_state_keeps_other_outputs) {
+    Fixture f;
+    f.device.begin();
+    uint32_t seed = 0x12345678;
+    for (uint8_t configuration = RGB; configuration <= ABRG; configuration++) {
+        f.device.setLEDConfiguration((LED_Configuration)configuration);
+        bool rgb = configuration < RGBA;
+        uint8_t channels = rgb ? 3 : 4;
+        for (uint16_t led = 0; led < 8; led++) {
+            for (uint8_t state = 0; state < 4; state++) {
+                // Random output states before the change
+                uint32_t ledout = 0;
+                for (uint8_t i = 0; i < 4; i++) {
+                    seed = seed * 1103515245 + 12345;
+                    f.model.registers[PCA9622_LED_OUT0 + i] = seed >> 24;
+                    ledout |= (uint32_t)(seed >> 24) << (i * 8);
+                }
+                f.device.setLEDOutputState(led, (LED_State)state);
+
+                uint8_t clamped = rgb ? (led > 4 ? 4 : led) : (led > 3 ? 3 : led);
+                uint32_t after = 0;
+                for (uint8_t i = 0; i < 4; i++) {
+                    after |= (uint32_t)f.model.registers[PCA9622_LED_OUT0 + i] << (i * 8);
+                }
+                for (uint8_t output = 0; output < 16; output++) {
+                    uint8_t expected = (ledout >> (output * 2)) & 0x03;
+                    if (output / channels == clamped && (rgb ? output < 15 : true)) expected = state;
+                    if (!CHECK_EQ((after >> (output * 2)) & 0x03, expected)) {
+                        printf("  configuration %u led %u state %u output %u\n", configuration, led, state, output);
+                        return;
+                    }
+                }
+            }
+        }
+    }
+}
+
+
+/*----------------------- Color conversion -----------------------------------*/
+
+/**
+ * @brief Checks a converted color. The hue wheel has 256 steps, so 85 and 170 are just before green and blue
+ * 
+ */
+#define CHECK_RGB(rgb, red, green, blue) do { \
+        CHECK_EQ((rgb)[0], red); \
+        CHECK_EQ((rgb)[1], green); \
+        CHECK_EQ((rgb)[2], blue); \
+    } while (0)
+
+TEST(hsv_converts_primaries_and_greys) {
+    uint8_t rgb[3];
+    PCA9622::hsvToRGB(0, 255, 255, rgb);
+    CHECK_RGB(rgb, 255, 0, 0);
+    PCA9622::hsvToRGB(85, 255, 255, rgb);
+    CHECK_RGB(rgb, 2, 255, 0);
+    PCA9622::hsvToRGB(170, 255, 255, rgb);
+    CHECK_RGB(rgb, 0, 4, 255);
+    PCA9622::hsvToRGB(0, 128, 255, rgb);
+    CHECK_RGB(rgb, 255, 127, 127);
+    PCA9622::hsvToRGB(0, 0, 100, rgb);
+    CHECK_RGB(rgb, 100, 100, 100);
+    PCA9622::hsvToRGB(170, 255, 0, rgb);
+    CHECK_RGB(rgb, 0, 0, 0);
+}
+
+TEST(hsl_gives_a_pure_color_at_half_lightness) {
+    uint8_t rgb[3];
+    PCA9622::hslToRGB(0, 255, 128, rgb);
+    CHECK_RGB(rgb, 255, 0, 0);
+    PCA9622::hslToRGB(0, 255, 127, rgb);
+    CHECK_RGB(rgb, 255, 0, 0);
+    PCA9622::hslToRGB(85, 255, 128, rgb);
+    CHECK_RGB(rgb, 2, 255, 0);
+    PCA9622::hslToRGB(170, 255, 128, rgb);
+    CHECK_RGB(rgb, 0, 4, 255);
+    PCA9622::hslToRGB(0, 255, 64, rgb);
+    CHECK_RGB(rgb, 129, 0, 0);
+    PCA9622::hslToRGB(0, 255, 192, rgb);
+    CHECK_RGB(rgb, 255, 129, 129);
+    PCA9622::hslToRGB(0, 128, 128, rgb);
+    CHECK_RGB(rgb, 192, 64, 64);
+}
+
+TEST(hsl_converts_greys_black_and_white) {
+    uint8_t rgb[3];
+    for (uint16_t lightness = 0; lightness <= 255; lightness++) {
+        PCA9622::hslToRGB(43, 0, lightness, rgb);
+        CHECK_RGB(rgb, lightness, lightness, lightness);
+    }
+    PCA9622::hslToRGB(43, 255, 0, rgb);
+    CHECK_RGB(rgb, 0, 0, 0);
+    PCA9622::hslToRGB(43, 255, 255, rgb);
+    CHECK_RGB(rgb, 255, 255, 255);
+}
+
+TEST(kelvin_interpolates_and_clamps_to_the_table) {
+    uint8_t rgb[3];
+    PCA9622::kelvinToRGB(PCA9622_KELVIN_MIN, 255, rgb);
+    CHECK_RGB(rgb, 255, 68, 0);
+    PCA9622::kelvinToRGB(500, 255, rgb);
+    CHECK_RGB(rgb, 255, 68, 0);
+    PCA9622::kelvinToRGB(PCA9622_KELVIN_MAX, 255, rgb);
+    CHECK_RGB(rgb, 191, 211, 255);
+    PCA9622::kelvinToRGB(60000, 255, rgb);
+    CHECK_RGB(rgb, 191, 211, 255);
+    // Halfway between the 1000K and 1512K entries
+    PCA9622::kelvinToRGB(1256, 255, rgb);
+    CHECK_RGB(rgb, 255, 88, 0);
+    PCA9622::kelvinToRGB(PCA9622_KELVIN_MIN, 128, rgb);
+    CHECK_RGB(rgb, 128, 34, 0);
+    PCA9622::kelvinToRGB(6632, 0, rgb);
+    CHECK_RGB(rgb, 0, 0, 0);
+}
+
+
+/*----------------------- Register model and shadow --------------------------*/
+
+TEST(auto_increment_rolls_over_per_datasheet) {
+    Fixture f;
+    f.device.begin();
+    uint8_t data[4] = {0xE2, 0xE0, 0x01, 0x05};
+    // AI_ALL rolls over from ALLCALLADR to MODE1
+    f.device.writeMultiRegister(PCA9622_SUB_ADR3 | PCA9622_AI_ALL, data, 4);
+    CHECK_EQ(f.model.registers[PCA9622_SUB_ADR3], 0xE2);
+    CHECK_EQ(f.model.registers[PCA9622_ALL_CALL], 0xE0);
+    CHECK_EQ(f.model.registers[PCA9622_MODE1], 0x81); // AI bits read only, awake
+    CHECK_EQ(f.model.registers[PCA9622_MODE2], 0x05);
+    CHECK(!f.device.isAsleep());
+
+    // AI_INDIVIDUAL rolls over from PWM15 to PWM0, GRPPWM stays untouched
+    f.device.writeRepeatRegister((PCA9622_PWM0 + 15) | PCA9622_AI_INDIVIDUAL, 0x42, 2);
+    CHECK_EQ(f.model.registers[PCA9622_PWM0 + 15], 0x42);
+    CHECK_EQ(f.model.registers[PCA9622_PWM0], 0x42);
+    CHECK_EQ(f.model.registers[PCA9622_GRPPWM], 0xFF);
+#ifndef PCA9622_LOW_FOOTPRINT
+    CHECK(f.device.matchesShadow(PCA9622_PWM0, 0x42));
+#endif
+
+    // AI_GLOBAL rolls over from GRPFREQ to GRPPWM
+    uint8_t global[3] = {0x10, 0x20, 0x30};
+    f.device.writeMultiRegister(PCA9622_GRPPWM | PCA9622_AI_GLOBAL, global, 3);
+    CHECK_EQ(f.model.registers[PCA9622_GRPPWM], 0x30);
+    CHECK_EQ(f.model.registers[PCA9622_GRPFREQ], 0x20);
+    CHECK_EQ(f.model.registers[PCA9622_LED_OUT0], 0xFF);
+
+    // AI_INDI_GLOBAL rolls over from GRPFREQ to PWM0
+    f.device.writeRepeatRegister(PCA9622_GRPFREQ | PCA9622_AI_INDI_GLOBAL, 0x00, 2);
+    CHECK_EQ(f.model.registers[PCA9622_GRPFREQ], 0x00);
+    CHECK_EQ(f.model.registers[PCA9622_PWM0], 0x00);
+#ifndef PCA9622_LOW_FOOTPRINT
+    CHECK(f.device.matchesShadow(PCA9622_PWM0, 0x00));
+#endif
+}
+
+#ifndef PCA9622_LOW_FOOTPRINT
+TEST(shadow_matches_device_after_writes) {
+    Fixture f;
+    f.device.begin();
+    f.device.setPWMOutput(3, 10);
+    f.device.setLEDOutputState(2, LED_State::ON);
+    f.device.setAllLEDColor(0, 20, 0);
+    f.device.sleep();
+    for (uint8_t reg = 0; reg < MODEL_REGISTER_COUNT; reg++) {
+        CHECK(f.device.matchesShadow(reg, f.model.registers[reg]));
+    }
+    CHECK(f.device.isAsleep());
+    CHECK_EQ(f.other.writes, 0);
+}
+#endif
+
+
+/*----------------------- Output enable --------------------------------------*/
+
+#ifndef PCA9622_LOW_FOOTPRINT
+#define OE_PIN 9
+
+/**
+ * @brief Returns the duty cycle of an output including the ~OE pin, which is active low
+ * 
+ */
+static uint8_t outputDuty(const PCA9622Model &model, uint8_t output) {
+    const MockPin &pin = mock_pins[OE_PIN];
+    if (!pin.analog) return (pin.value == LOW) ? model.duty(output) : 0;
+    return ((uint16_t)model.duty(output) * (0xFF - pin.value)) / 0xFF;
+}
+
+TEST(output_brightness_combines_with_the_group_pwm) {
+    PCA9622Model model(0xA2);
+    Wire.attach(&model);
+    PCA9622 device(0xA2, OE_PIN);
+    device.begin();
+    CHECK_EQ(outputDuty(model, 0), 0);
+    device.enableOutputs();
+    device.setAllPWMOutputs(200);
+    device.setGroupPWM(128);
+    CHECK_EQ(outputDuty(model, 0), 100);
+
+    // The brightness costs no I2C traffic
+    uint32_t transactions = Wire.transactions;
+    device.setOutputBrightness(128);
+    CHECK_EQ(Wire.transactions, transactions);
+    CHECK(mock_pins[OE_PIN].analog);
+    CHECK_EQ(mock_pins[OE_PIN].value, 127);
+    CHECK_EQ(outputDuty(model, 5), 50);
+
+    // Enabling the outputs again restores the last brightness
+    device.disableOutputs();
+    CHECK_EQ(outputDuty(model, 5), 0);
+    device.enableOutputs();
+    CHECK_EQ(outputDuty(model, 5), 50);
+    CHECK_EQ(device.getOutputBrightness(), 128);
+
+    device.setOutputBrightness(128, true);
+    CHECK_EQ(device.getOutputBrightness(), PCA9622::gammaCorrect(128));
+}
+
+TEST(output_brightness_uses_digital_levels_at_the_edges) {
+    PCA9622Model model(0xA2);
+    Wire.attach(&model);
+    PCA9622 device(0xA2, OE_PIN);
+    device.begin();
+    device.setAllPWMOutputs(200);
+
+    device.setOutputBrightness(0);
+    CHECK(!mock_pins[OE_PIN].analog);
+    CHECK_EQ(mock_pins[OE_PIN].value, HIGH);
+    CHECK_EQ(outputDuty(model, 0), 0);
+    device.enableOutputs();
+    CHECK_EQ(mock_pins[OE_PIN].value, HIGH);
+
+    device.setOutputBrightness(255);
+    CHECK(!mock_pins[OE_PIN].analog);
+    CHECK_EQ(mock_pins[OE_PIN].value, LOW);
+    CHECK_EQ(outputDuty(model, 0), 200);
+    device.disableOutputs();
+    device.enableOutputs();
+    CHECK_EQ(mock_pins[OE_PIN].value, LOW);
+}
+#endif
+
+
+/*----------------------- Power management ---------------------------------*/
+
+#ifndef PCA9622_LOW_FOOTPRINT
+TEST(auto_sleep_puts_a_dark_device_to_sleep_after_the_timeout) {
+    Fixture f;
+    // The time before begin is not counted as sleep time
+    mock_advance(5000000);
+    f.device.begin();
+    CHECK_EQ(f.device.getSleepTime(), 0);
+    CHECK_EQ(f.device.getSleepCount(), 0);
+
+    f.device.setAutoSleep(100);
+    mock_advance(99000);
+    f.device.update();
+    CHECK(!f.model.isAsleep());
+    mock_advance(1000);
+    f.device.update();
+    CHECK(f.model.isAsleep());
+    CHECK(f.device.isAsleep());
+    CHECK_EQ(f.device.getSleepCount(), 1);
+
+    mock_advance(250000);
+    CHECK_EQ(f.device.getSleepTime(), 250);
+    CHECK_EQ(f.other.writes, 0);
+}
+
+TEST(auto_sleep_wakes_up_on_a_write_that_turns_an_output_on) {
+    Fixture f;
+    f.device.begin();
+    f.device.setAutoSleep(100);
+    mock_advance(100000);
+    f.device.update();
+    CHECK(f.model.isAsleep());
+
+    // Writing a dark value keeps the device asleep
+    mock_advance(40000);
+    f.device.setPWMOutput(0, 0);
+    CHECK(f.model.isAsleep());
+    f.device.setPWMOutput(0, 10);
+    CHECK(!f.model.isAsleep());
+    CHECK(!f.device.isAsleep());
+    CHECK_EQ(f.model.registers[PCA9622_PWM0], 10);
+    CHECK_EQ(f.device.getSleepTime(), 40);
+
+    // A lit device stays awake, the sleep time stops counting
+    mock_advance(500000);
+    f.device.update();
+    CHECK(!f.model.isAsleep());
+    CHECK_EQ(f.device.getSleepTime(), 40);
+    CHECK_EQ(f.device.getSleepCount(), 1);
+}
+
+TEST(schedule_activity_wakes_up_before_the_transition) {
+    Fixture f;
+    f.device.begin();
+    f.device.setAutoSleep(100);
+    mock_advance(100000);
+    f.device.update();
+    CHECK(f.model.isAsleep());
+
+    // Woken up the oscillator start up time before the announced transition
+    f.device.scheduleActivity(10);
+    mock_advance(8000);
+    f.device.update();
+    CHECK(f.model.isAsleep());
+    mock_advance(1000);
+    f.device.update();
+    CHECK(!f.model.isAsleep());
+    CHECK_EQ(f.device.getSleepTime(), 9);
+
+    // Without the transition the timeout starts over
+    mock_advance(99000);
+    f.device.update();
+    CHECK(!f.model.isAsleep());
+    mock_advance(1000);
+    f.device.update();
+    CHECK(f.model.isAsleep());
+    CHECK_EQ(f.device.getSleepCount(), 2);
+}
+#endif
+
+
+/*----------------------- Asynchronous sequences -----------------------------*/
+
+#ifndef PCA9622_LOW_FOOTPRINT
+/**
+ * @brief Polls a sequence to the end and checks that every call does at most one register access. 
+ * A register read starts with a write of the control register, so a read and a write in one call are two write transactions
+ * 
+ */
+static void pollSequence(Fixture &f) {
+    for (uint8_t steps = 0; steps < 100; steps++) {
+        uint32_t writes = f.model.writes;
+        bool busy = f.device.poll(micros());
+        if (!CHECK(f.model.writes - writes <= 1) || !busy) return;
+        mock_advance(100);
+    }
+    CHECK(false);
+}
+
+TEST(async_sequences_do_one_register_access_per_poll) {
+    Fixture f;
+    CHECK(f.device.beginAsync());
+    CHECK(!f.device.beginAsync());
+    pollSequence(f);
+    CHECK(!f.device.isBusy());
+    CHECK(!f.model.isAsleep());
+    CHECK_EQ(f.model.registers[PCA9622_LED_OUT0], 0xFF);
+    CHECK_EQ(f.model.wakeUps, 1);
+
+    f.device.sleep();
+    CHECK(f.device.wakeUpAsync());
+    pollSequence(f);
+    CHECK(!f.model.isAsleep());
+    CHECK(!f.device.isAsleep());
+    CHECK_EQ(f.model.wakeUps, 2);
+}
+#endif
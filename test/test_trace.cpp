@@ -0,0 +1,67 @@
+/**
+ * @file test_trace.cpp
+ * @brief Host tests of the binary I2C trace, see I2C_coms.h
+ * 
+ */
+#include "test.h"
+#include "PCA9622.h"
+#include "PCA9622Model.h"
+
+/**
+ * @brief Collects the trace in memory
+ * 
+ */
+class TraceBuffer : public Print
+{
+public:
+    size_t write(uint8_t data) override {
+        if (length < sizeof(data_)) data_[length++] = data;
+        return 1;
+    }
+    uint8_t data_[256];
+    size_t length = 0;
+};
+
+/**
+ * @brief Returns the position of the bus byte of a record, all fields before it are single bytes in these tests
+ * 
+ */
+static size_t busField(size_t record) {
+    return record + 3;
+}
+
+TEST(trace_records_the_bus_of_every_transaction) {
+    PCA9622Model first(0xA2);
+    PCA9622Model second(0xA2);
+    Wire.attach(&first);
+    Wire1.attach(&second);
+    PCA9622 devices[2] = {PCA9622(0xA2), PCA9622(0xA2)};
+    devices[1].setBus(&Wire1);
+
+    TraceBuffer trace;
+    PCA9622::setTrace(&trace);
+    devices[1].setPWMOutput(0, 0x11); // The first record on Wire1, still Wire1 gets bus 1 as Wire is always 0
+    devices[0].setPWMOutput(0, 0x22);
+    devices[1].setOutputEnablePin(9);
+    devices[1].disableOutputs();
+    PCA9622::setTrace(nullptr);
+
+    CHECK_EQ(trace.data_[0], 'P');
+    CHECK_EQ(trace.data_[1], 'T');
+    CHECK_EQ(trace.data_[2], 3);
+    // Records of a single byte write: flags, delta, duration, bus, address, register, length, data
+    size_t record = 3;
+    CHECK_EQ(trace.data_[busField(record)], 1);
+    CHECK_EQ(trace.data_[busField(record) + 1], 0xA2);
+    CHECK_EQ(trace.data_[busField(record) + 4], 0x11);
+    record += 8;
+    CHECK_EQ(trace.data_[busField(record)], 0);
+    CHECK_EQ(trace.data_[busField(record) + 1], 0xA2);
+    CHECK_EQ(trace.data_[busField(record) + 4], 0x22);
+    record += 8;
+    // The output enable record holds the bus of the device as well
+    CHECK_EQ(trace.data_[record], 0x02);
+    CHECK_EQ(trace.data_[busField(record)], 1);
+    CHECK_EQ(trace.data_[busField(record) + 1], 0xA2);
+    CHECK_EQ(trace.length, record + 8);
+}